@@ -33,9 +33,32 @@
 
 // - - Inclusion - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+#include <math.h>
 #include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <fcntl.h>
+#include <io.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 #include "arithmetic_codec.h"
+#include "checksum.h"
+#include "bwt_codec.h"
+#include "lz77_codec.h"
+#include "ppm_codec.h"
 
 
 // - - Constants - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -43,21 +66,302 @@
 const char * W_MSG = "cannot write to file";
 const char * R_MSG = "cannot read from file";
 
-const unsigned NumModels  = 16;                          // MUST be power of 2
-
 const unsigned FILE_ID    = 0xB8AA3B29U;
+const unsigned BLOCK_ID   = 0xB8AA3B2AU;     // independent blocks, streamable
+const unsigned CRC32C_ID  = 0x00000004U;       // ID flag: CRC32C, not old CRC
+const unsigned INDEX_ID   = 0x00000010U;     // ID flag: block index in footer
+const unsigned CONTEXT_ID = 0x00000040U;       // ID flag: header context word
 
 const unsigned BufferSize = 65536;
 
+const unsigned DefaultOrder   = 1;     // context: low 4 bits of previous byte
+const unsigned DefaultBits    = 4;
+const unsigned DefaultBits2   = 12;           // order 2: hash of last 2 bytes
+const unsigned MaxContextBits = 16;         // 2^16 models: ~150 MB per thread
+
+const unsigned DefaultBlockKB = 1024;       // size of independent blocks (KB)
+const unsigned MaxBlockKB     = 4096;
+
+const unsigned StoredBlock   = 0x80000000U;  // code-size flag: raw data block
+const unsigned SampleChunks  = 64;       // entropy of sampled data decides if
+const unsigned ChunkBytes    = 256;            // block is coded or stored raw
+const double   EntropyLimit  = 7.9;                           // bits per byte
+
+const unsigned NotSpecified   = ~0U;           // context order not in options
+
+const unsigned ContextMethod = 0;        // coding methods, saved in byte 2 of
+const unsigned LZ77Method    = 1;                // context word of the header
+const unsigned BWTMethod     = 2;
+const unsigned PPMMethod     = 3;
+
+const unsigned PPMMaxOrder   = 8;          // PPM: longest context, bytes, and
+const unsigned PPMDefaultOrder = 8;
+const unsigned PPMMaxBits    = 10;          // trie memory: 2^bits MB, up to 1
+const unsigned PPMDefaultBits = 5;                        // GB, default 32 MB
+
+const unsigned BlocksPerThread = 4;             // blocks in flight per thread
+const unsigned ClassicJobs     = 4;        // blocks in flight, classic format
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// - - Data structures - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+struct Block_Job                  // one block of the independent-block format
+{
+  unsigned char *  data;                          // block's uncompressed data
+  unsigned char *  memory;                     // 0 if data is in file mapping
+  unsigned         bytes, code_bytes, crc;
+  bool             stored;                       // data not coded, copied raw
+  unsigned long long sequence;                          // block order in file
+  Arithmetic_Codec codec;                // compressed data is in codec buffer
+};
+
+struct Block_Entry              // block index entry (20 bytes in file footer)
+{
+  unsigned long long code_offset;           // position of block in compressed
+  unsigned long long data_offset;                  // and in uncompressed file
+  unsigned           crc;
+};
+
+struct Context_Options                             // selection of data models
+{
+  unsigned order, bits;          // 0 to 2 previous bytes select 2^bits models
+  unsigned method;             // LZ77 & BWT: context models code the literals
+                                                // or classes of the MTF ranks
+};
+
+struct Level_Preset                     // options selected by -1 to -9 levels
+{
+  unsigned block_KB, order, bits;
+};
+
+struct Coding_Options                                  // command-line options
+{
+  unsigned threads, block_KB, level;                      // 0 = not specified
+  bool     force;                                  // overwrite without asking
+  bool     verbose;                                 // report stage throughput
+  bool     seekable;                          // block format with block index
+  bool     range;                                 // decode only a byte range:
+  unsigned long long first_byte, range_bytes;     // range_bytes ~0: to end
+  Context_Options    context;                       // data models for coding
+};
+
+struct File_Map                               // regular file mapped to memory
+{
+  unsigned char * data;                       // 0 if file could not be mapped
+  size_t          bytes;
+#ifdef _WIN32
+  HANDLE          mapping;
+#endif
+};
+
+                  // levels from fast to best compression, chosen by measuring
+const Level_Preset Preset[9] = {         // ratio & speed (table in README.md)
+  {  256, 0,  0 },
+  {  256, 1,  4 },
+  {  256, 1,  6 },
+  {  256, 1,  8 },
+  { 1024, 1,  7 },
+  { 1024, 1,  8 },
+  { 4096, 2, 10 },
+  { 4096, 2, 12 },
+  { 4096, 2, 14 } };
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// - - Class definitions - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+class Job_Queue                             // thread-safe queue of block jobs
+{
+public:
+
+  Job_Queue(void) { closed = false; }
+
+  void        push(Block_Job * job);
+  Block_Job * pop(void);                   // waits; 0 if closed and now empty
+  void        close(void);
+
+private:  //  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .
+  std::deque<Block_Job *> jobs;
+  std::mutex              access;
+  std::condition_variable change;
+  bool                    closed;
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+class Coder_Models          // byte models and method engine of a coder thread
+{
+public:
+
+  Coder_Models(const Context_Options & options);
+ ~Coder_Models(void);
+
+  void reset(void);                            // all models start a new block
+
+  Adaptive_Data_Model & operator [] (unsigned history)
+  {
+    return bytes[history];
+  }
+
+  unsigned history;                         // kept between calls to the coder
+
+  Context_Model bytes;                 // also LZ77 literals, BWT rank classes
+  LZ77_Codec * lz77;                                   // 0 if not LZ77 method
+  BWT_Codec  * bwt;                                     // 0 if not BWT method
+  PPM_Codec  * ppm;                                     // 0 if not PPM method
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+class Block_Pipeline    // reader, coder threads, and writer, linked by queues
+{
+public:
+
+  Block_Pipeline(const Context_Options & options) : context(options) {}
+                        // a fixed set of jobs is reused, so at most that many
+  void run(unsigned coder_threads,           // blocks are in memory at a time
+           unsigned number_of_jobs,
+           unsigned block_size,
+           bool mapped_data);
+
+  void report_stages(FILE * report);      // stage throughput and model memory
+
+  virtual ~Block_Pipeline(void) {}
+
+protected:  //  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .
+  virtual bool read_block(Block_Job & job) = 0;     // false if no more blocks
+  virtual void code_block(Block_Job & job,            // each coder thread has
+                          Coder_Models & model) = 0;    // its own data models
+  virtual void write_block(Block_Job & job) = 0;      // called in block order
+
+private:  //  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .
+  void reader(void);
+  void coder(void);
+  void writer(void);
+  Job_Queue free_jobs, read_jobs, coded_jobs;
+  Block_Job ** pending;                       // coded jobs waiting for writer
+  unsigned jobs, coders;
+  unsigned long long bytes;
+  Context_Options context;
+  double read_time, code_time, write_time;                     // busy seconds
+  double run_time;
+  std::mutex time_access;
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+class Block_Encoder : public Block_Pipeline    // independent blocks, parallel
+{
+public:
+  Block_Encoder(FILE * data_file, FILE * code_file, const File_Map & map,
+                unsigned block_size, const Context_Options & context,
+                unsigned header_bytes);
+  unsigned long long data_bytes, code_bytes;
+  unsigned crc;
+  std::vector<Block_Entry> index;
+protected:  //  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .
+  bool read_block(Block_Job & job);
+  void code_block(Block_Job & job, Coder_Models & model);
+  void write_block(Block_Job & job);
+private:  //  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .
+  FILE * data_file, * code_file;
+  const File_Map & map;
+  unsigned block_size;
+  bool end_of_data;
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+class Block_Decoder : public Block_Pipeline
+{
+public:
+  Block_Decoder(FILE * code_file, FILE * data_file, const File_Map & map,
+                unsigned block_size, const Context_Options & context,
+                unsigned header_bytes, bool crc32c);
+  unsigned long long data_bytes, code_bytes;
+  unsigned crc;
+  std::vector<Block_Entry> index;                    // rebuilt while decoding
+protected:  //  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .
+  bool read_block(Block_Job & job);
+  void code_block(Block_Job & job, Coder_Models & model);
+  void write_block(Block_Job & job);
+  FILE * code_file, * data_file;
+  const File_Map & map;
+  unsigned block_size;
+  bool crc32c, end_of_data;
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+class Range_Decoder : public Block_Decoder   // decodes only the blocks needed
+{                                                  // for a range of file data
+public:
+  Range_Decoder(FILE * code_file, FILE * data_file, const File_Map & map,
+                unsigned block_size, const Context_Options & context,
+                const Block_Entry * first_entry,
+                unsigned long long blocks, unsigned long long first_byte,
+                unsigned long long end_byte);
+protected:  //  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .
+  bool read_block(Block_Job & job);
+  void write_block(Block_Job & job);
+private:  //  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .
+  const Block_Entry * entry;
+  unsigned long long blocks_left, first_byte, end_byte;
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+class Classic_Encoder : public Block_Pipeline     // one coder, shared models
+{
+public:
+  Classic_Encoder(FILE * data_file, FILE * code_file, const File_Map & map,
+                  const Context_Options & context);
+  unsigned long long code_bytes;
+  unsigned data_bytes, crc;
+protected:  //  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .
+  bool read_block(Block_Job & job);
+  void code_block(Block_Job & job, Coder_Models & model);
+  void write_block(Block_Job & job);
+private:  //  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .
+  FILE * data_file, * code_file;
+  const File_Map & map;
+  bool end_of_data;
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+class Classic_Decoder : public Block_Pipeline
+{
+public:
+  Classic_Decoder(FILE * code_file, FILE * data_file, const File_Map & map,
+                  const Context_Options & context, unsigned data_bytes,
+                  bool crc32c);
+  unsigned crc;
+protected:  //  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .
+  bool read_block(Block_Job & job);
+  void code_block(Block_Job & job, Coder_Models & model);
+  void write_block(Block_Job & job);
+private:  //  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .
+  FILE * code_file, * data_file;
+  const File_Map & map;
+  unsigned bytes_left;
+  bool crc32c, end_of_data;
+};
+
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 // - - Prototypes  - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
 void Encode_File(char * data_file_name,
-                 char * code_file_name);
+                 char * code_file_name,
+                 const Coding_Options & options);
 
 void Decode_File(char * code_file_name,
-                 char * data_file_name);
+                 char * data_file_name,
+                 const Coding_Options & options);
+
+bool Valid_Context(const Context_Options & context);
 
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -65,18 +369,122 @@ void Decode_File(char * code_file_name,
 
 int main(int numb_arg, char * arg[])
 {
+  Coding_Options options = Coding_Options();           // read program options
+  options.context.order = NotSpecified;
+  int n = 2;
+  bool ok = (numb_arg >= 4) && (arg[1][0] == '-') &&
+            ((arg[1][1] == 'c') || (arg[1][1] == 'd')) && (arg[1][2] == 0);
+  for (; ok && (n < numb_arg - 2); n++) {
+    if (strcmp(arg[n], "-f") == 0) {
+      options.force = true;
+      continue;
+    }
+    if (strcmp(arg[n], "-v") == 0) {
+      options.verbose = true;
+      continue;
+    }
+    if (strcmp(arg[n], "-s") == 0) {
+      options.seekable = true;
+      continue;
+    }
+    if ((arg[n][0] == '-') && (arg[n][1] == 'r')) {   // -r#,# or -r# (to end)
+      char * end = 0;
+      options.range = true;
+      options.first_byte = strtoull(arg[n] + 2, &end, 10);
+      options.range_bytes = ~0ULL;
+      ok = (end != arg[n] + 2);
+      if (ok && (*end == ',')) {
+        char * count = end + 1;
+        options.range_bytes = strtoull(count, &end, 10);
+        ok = (end != count);
+      }
+      ok = ok && (*end == 0) && (arg[1][1] == 'd');
+      continue;
+    }
+    if ((arg[n][0] == '-') && (arg[n][1] >= '1') && (arg[n][1] <= '9') &&
+        (arg[n][2] == 0)) {
+      options.level = unsigned(arg[n][1] - '0');
+      ok = (arg[1][1] == 'c');
+      continue;
+    }
+    char * end = 0;
+    unsigned value = unsigned(strtoul(arg[n] + 2, &end, 10));
+    ok = (arg[n][0] == '-') && (end != arg[n] + 2) && (*end == 0);
+    if (ok && (arg[n][1] == 't') && (value >= 1) && (value <= 1024))
+      options.threads = value;
+    else
+      if (ok && (arg[n][1] == 'b') && (value >= 4) && (value <= MaxBlockKB))
+        options.block_KB = value;
+      else
+        if (ok && (arg[n][1] == 'o') && (value <= PPMMaxOrder))
+          options.context.order = value;
+        else
+          if (ok && (arg[n][1] == 'x') && (value >= 1) &&
+              (value <= MaxContextBits))
+            options.context.bits = value;
+          else
+            if (ok && (arg[n][1] == 'm') && (value <= PPMMethod) &&
+                (arg[1][1] == 'c'))
+              options.context.method = value;
+            else
+              ok = false;
+  }
+                          // level sets options that were not given explicitly
+  bool ppm_method = (options.context.method == PPMMethod);
+  if (options.level) {                           // (PPM: only the block size)
+    const Level_Preset & preset = Preset[options.level-1];
+    if (options.block_KB == 0) options.block_KB = preset.block_KB;
+    if ((options.context.order == NotSpecified) && !ppm_method) {
+      options.context.order = preset.order;
+      if (options.context.bits == 0) options.context.bits = preset.bits;
+    }
+  }
+  if (options.context.order == NotSpecified)
+    options.context.order = (ppm_method ? PPMDefaultOrder : DefaultOrder);
+                                         // default number of bits for context
+  if (options.context.bits == 0) {
+    if (options.context.order == 1) options.context.bits = DefaultBits;
+    if (options.context.order == 2) options.context.bits = DefaultBits2;
+    if (ppm_method) options.context.bits = PPMDefaultBits;
+  }
+  ok = ok && Valid_Context(options.context);
                                                        // define program usage
-  if ((numb_arg != 4) || (arg[1][0] != '-') || 
-     ((arg[1][1] != 'c') && (arg[1][1] != 'd'))) {
-    puts("\n\t Compression parameters:   acfile -c data_file compressed_file");
-    puts("\n\t Decompression parameters: acfile -d compressed_file new_file\n");
+  if (!ok) {
+    puts("\n\t Compression parameters:   acfile -c [options] data_file "
+         "compressed_file");
+    puts("\n\t Decompression parameters: acfile -d [options] compressed_file "
+         "new_file");
+    puts("\n\t Options: -t#  number of threads, independent blocks "
+         "(default: all cores)");
+    printf("\t          -b#  size of independent blocks in KB "
+           "(4 to %d, default %d)\n", MaxBlockKB, DefaultBlockKB);
+    puts("\t          -f   overwrite output file without asking");
+    puts("\t          -v   report throughput of read, code & write stages");
+    puts("\t          -1 to -9  compression level: fast to best (sets -b, "
+         "-o & -x)");
+    puts("\t          -s   seekable: independent blocks with block index");
+    printf("\t          -o#  context order: previous bytes used (0 to 2, "
+           "default %d;\n\t               PPM: longest context, 1 to %d, "
+           "default %d)\n", DefaultOrder, PPMMaxOrder, PPMDefaultOrder);
+    printf("\t          -x#  context bits: 2^# models (order 1: up to 8, "
+           "default %d;\n\t               order 2: up to %d, default %d; "
+           "PPM: 2^# MB of\n\t               memory, up to %d, default %d)\n",
+           DefaultBits, MaxContextBits, DefaultBits2, PPMMaxBits,
+           PPMDefaultBits);
+    puts("\t          -m#  coding method: 0 = context models (default), "
+         "1 = LZ77\n\t               matches, 2 = block sorting (BWT), "
+         "3 = PPM; context\n\t               models code LZ77 literals "
+         "and BWT move-to-front ranks");
+    puts("\t          -r#,# decode only byte range (first byte, number of "
+         "bytes)\n\t               of seekable file; -r# decodes to end");
+    puts("\n\t Use - as file name for standard input or output\n");
     exit(0);
   }
 
   if (arg[1][1] == 'c')
-    Encode_File(arg[2], arg[3]);
+    Encode_File(arg[n], arg[n+1], options);
   else
-    Decode_File(arg[2], arg[3]);
+    Decode_File(arg[n], arg[n+1], options);
 
   return 0;
 }
@@ -93,34 +501,14 @@ void Error(const char * s)
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-unsigned Buffer_CRC(unsigned bytes,
-                    unsigned char * buffer)
-{
-  static const unsigned CRC_Gen[8] = {        // data for generating CRC table
-    0xEC1A5A3EU, 0x5975F5D7U, 0xB2EBEBAEU, 0xE49696F7U,
-    0x486C6C45U, 0x90D8D88AU, 0xA0F0F0BFU, 0xC0A0A0D5U };
-
-  static unsigned CRC_Table[256];            // table for fast CRC computation
-
-  if (CRC_Table[1] == 0)                                      // compute table
-    for (unsigned k = CRC_Table[0] = 0; k < 8; k++) {
-      unsigned s = 1 << k, g = CRC_Gen[k];
-      for (unsigned n = 0; n < s; n++) CRC_Table[n+s] = CRC_Table[n] ^ g;
-    }
-
-                                  // computes buffer's cyclic redundancy check
-  unsigned crc = 0;
-  if (bytes)
-    do {
-      crc = (crc >> 8) ^ CRC_Table[(crc&0xFFU)^unsigned(*buffer++)];
-    } while (--bytes);
-  return crc;
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-
 FILE * Open_Input_File(char * file_name)
 {
+  if (strcmp(file_name, "-") == 0) {                  // standard input stream
+#ifdef _WIN32
+    _setmode(_fileno(stdin), _O_BINARY);
+#endif
+    return stdin;
+  }
   FILE * new_file = fopen(file_name, "rb");
   if (new_file == 0) Error("cannot open input file");
   return new_file;
@@ -128,17 +516,25 @@ FILE * Open_Input_File(char * file_name)
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-FILE * Open_Output_File(char * file_name)
+FILE * Open_Output_File(char * file_name,
+                        bool force,
+                        bool reading_stdin)
 {
-  FILE * new_file = fopen(file_name, "rb");
+  if (strcmp(file_name, "-") == 0) {                 // standard output stream
+#ifdef _WIN32
+    _setmode(_fileno(stdout), _O_BINARY);
+#endif
+    return stdout;
+  }
+  FILE * new_file = (force ? 0 : fopen(file_name, "rb"));
   if (new_file != 0) {
-    fclose(new_file);
+    fclose(new_file);                      // cannot ask if stdin has the data
+    if (reading_stdin) Error("output file exists (use -f to overwrite)");
     printf("\n Overwrite file %s? (y = yes, otherwise quit) ", file_name);
     char line[128];
-    gets(line);
-    if (line[0] != 'y') exit(0);
+    if ((fgets(line, sizeof(line), stdin) == 0) || (line[0] != 'y')) exit(0);
   }
-  new_file = fopen(file_name, "wb");
+  new_file = fopen(file_name, "w+b");               // read access for mapping
   if (new_file == 0) Error("cannot open output file");
   return new_file;
 }
@@ -163,115 +559,1142 @@ unsigned Recover_Number(unsigned char * b)
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-void Encode_File(char * data_file_name,
-                 char * code_file_name)
+void Save_Number64(unsigned long long n, unsigned char * b)
+{                                                   // decompose 8-byte number
+  Save_Number(unsigned(n & 0xFFFFFFFFU), b);
+  Save_Number(unsigned(n >> 32), b + 4);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+unsigned long long Recover_Number64(unsigned char * b)
+{                                                    // recover 8-byte integer
+  unsigned long long high = Recover_Number(b + 4);
+  return (high << 32) + Recover_Number(b);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+bool Regular_File_Size(FILE * file,
+                       unsigned long long & bytes)
 {
-                                                                 // open files
-  FILE * data_file = Open_Input_File(data_file_name);
-  FILE * code_file = Open_Output_File(code_file_name);
+  bytes = 0;                    // returns false for pipes, terminals, devices
+#ifdef _WIN32
+  HANDLE handle = HANDLE(_get_osfhandle(_fileno(file)));
+  LARGE_INTEGER size;
+  if ((GetFileType(handle) != FILE_TYPE_DISK) ||
+      !GetFileSizeEx(handle, &size)) return false;
+  bytes = (unsigned long long)(size.QuadPart);
+#else
+  struct stat info;
+  if (fstat(fileno(file), &info) || !S_ISREG(info.st_mode)) return false;
+  bytes = (unsigned long long)(info.st_size);
+#endif
+  return true;
+}
 
-                                                  // buffer for data file data
-  unsigned char * data = new unsigned char[BufferSize];
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-  unsigned nb, bytes = 0, crc = 0;       // compute CRC (cyclic check) of file
-  do {
-    nb = fread(data, 1, BufferSize, data_file);
-    bytes += nb;
-    crc ^= Buffer_CRC(nb, data);
-  } while (nb == BufferSize);
+bool Incompressible(unsigned bytes,
+                    const unsigned char * data)
+{                     // order-0 entropy of evenly spaced chunks of block data
+  unsigned count[256], samples = 0;
+  memset(count, 0, sizeof(count));
+  unsigned stride = bytes / SampleChunks;
+  if (stride < ChunkBytes) stride = ChunkBytes;
+  for (unsigned p = 0; p < bytes; p += stride) {
+    unsigned end = (bytes - p < ChunkBytes ? bytes : p + ChunkBytes);
+    for (unsigned q = p; q < end; q++) count[data[q]]++;
+    samples += end - p;
+  }
+  if (samples < 16 * ChunkBytes) return false;          // too little to judge
 
-                                                      // define 12-byte header
-  unsigned char header[12];
-  Save_Number(FILE_ID, header);
-  Save_Number(crc,      header + 4);
-  Save_Number(bytes,    header + 8);
-  if (fwrite(header, 1, 12, code_file) != 12) Error(W_MSG);
-                                                            // set data models
-  Adaptive_Data_Model dm[NumModels];
-  for (unsigned m = 0; m < NumModels; m++) dm[m].set_alphabet(256);
+  double bits = 0;
+  for (unsigned s = 0; s < 256; s++)
+    if (count[s]) bits -= count[s] * log(double(count[s]) / samples);
+  return (bits / log(2.0) > EntropyLimit * samples);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+bool Seek_File(FILE * file,
+               unsigned long long position)
+{                                               // 64-bit seek from file start
+#ifdef _WIN32
+  return _fseeki64(file, __int64(position), SEEK_SET) == 0;
+#else
+  return fseeko(file, off_t(position), SEEK_SET) == 0;
+#endif
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void Save_Entry(const Block_Entry & entry,
+                unsigned char * b)
+{                                            // save 20-byte block index entry
+  Save_Number64(entry.code_offset, b);
+  Save_Number64(entry.data_offset, b + 8);
+  Save_Number(entry.crc, b + 16);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void Recover_Entry(unsigned char * b,
+                   Block_Entry & entry)
+{                                         // recover 20-byte block index entry
+  entry.code_offset = Recover_Number64(b);
+  entry.data_offset = Recover_Number64(b + 8);
+  entry.crc = Recover_Number(b + 16);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+bool Valid_Context(const Context_Options & context)
+{
+  if (context.method > PPMMethod) return false;
+  if (context.method == PPMMethod)          // PPM: maximum order, memory bits
+    return (context.order >= 1) && (context.order <= PPMMaxOrder) &&
+           (context.bits >= 1) && (context.bits <= PPMMaxBits);
+  switch (context.order) {
+    case 0: return (context.bits == 0);
+    case 1: return (context.bits >= 1) && (context.bits <= 8);
+    case 2: return (context.bits >= 1) && (context.bits <= MaxContextBits);
+  }
+  return false;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+bool Default_Context(const Context_Options & context)
+{                          // only other contexts are saved in the file header
+  return (context.order == DefaultOrder) && (context.bits == DefaultBits) &&
+         (context.method == ContextMethod);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+unsigned Context_Word(const Context_Options & context)
+{                                   // header word: order, bits, method, and 0
+  return context.order | (context.bits << 8) | (context.method << 16);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+size_t Context_Memory(const Context_Options & context)
+{       // 256-symbol models: 2 x 256 counters + 66-entry table, 1 reset stamp
+  if (context.method == PPMMethod) return size_t(1) << (context.bits + 20);
+  return (size_t(1) << context.bits) *
+         (sizeof(Adaptive_Data_Model) + (2 * 256 + 67) * sizeof(unsigned));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+Context_Options Read_Context(FILE * code_file,
+                             unsigned id_flags)
+{
+  Context_Options context = { DefaultOrder, DefaultBits, ContextMethod };
+  if (id_flags & CONTEXT_ID) {          // 4-byte word: order, bits, method, 0
+    unsigned char word[4];
+    if (fread(word, 1, 4, code_file) != 4) Error(R_MSG);
+    context.order  = word[0];
+    context.bits   = word[1];
+    context.method = word[2];
+    if (word[3] || !Valid_Context(context))
+      Error("invalid compressed file");
+  }
+  return context;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+unsigned Number_of_Threads(const Coding_Options & options)
+{
+  if (options.threads) return options.threads;
+  unsigned threads = std::thread::hardware_concurrency();
+  return (threads ? threads : 1);              // default: all available cores
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+FILE * Report_Stream(FILE * output_file)
+{                                          // do not mix report with file data
+  return (output_file == stdout ? stderr : stdout);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void Report_Size(FILE * code_file,
+                 unsigned long long data_bytes,
+                 unsigned long long code_bytes)
+{
+  fprintf(Report_Stream(code_file),
+          " Compressed file size = %.0f bytes (%6.2f:1 compression)"
+          "\n", double(code_bytes), double(data_bytes) / double(code_bytes));
+}
 
-  Arithmetic_Codec encoder(BufferSize);                  // set encoder buffer
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-  rewind(data_file);                               // second pass to code file
+bool Map_Input_File(FILE * file,
+                    File_Map & map)
+{
+  map.data = 0;                              // map whole file for reading, or
+  map.bytes = 0;                         // return false if it is not possible
+#ifdef _WIN32
+  HANDLE handle = HANDLE(_get_osfhandle(_fileno(file)));
+  LARGE_INTEGER size;
+  if ((GetFileType(handle) != FILE_TYPE_DISK) ||
+      !GetFileSizeEx(handle, &size) || (size.QuadPart <= 0) ||
+      (LONGLONG(size_t(size.QuadPart)) != size.QuadPart)) return false;
+  map.mapping = CreateFileMapping(handle, 0, PAGE_READONLY, 0, 0, 0);
+  if (map.mapping == 0) return false;
+  map.data = (unsigned char *) MapViewOfFile(map.mapping, FILE_MAP_READ,
+                                             0, 0, 0);
+  if (map.data == 0) {
+    CloseHandle(map.mapping);
+    return false;
+  }
+  map.bytes = size_t(size.QuadPart);
+#else
+  struct stat info;
+  if (fstat(fileno(file), &info) || !S_ISREG(info.st_mode) ||
+      (info.st_size <= 0) || (off_t(size_t(info.st_size)) != info.st_size))
+    return false;
+  void * view = mmap(0, size_t(info.st_size), PROT_READ, MAP_PRIVATE,
+                     fileno(file), 0);
+  if (view == MAP_FAILED) return false;
+  madvise(view, size_t(info.st_size), MADV_SEQUENTIAL);
+  map.data = (unsigned char *) view;
+  map.bytes = size_t(info.st_size);
+#endif
+  return true;
+}
 
-  unsigned context = 0;
-  do {
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-    nb = (bytes < BufferSize ? bytes : BufferSize);
-    if (fread(data, 1, nb, data_file) != nb) Error(R_MSG);   // read file data
+bool Map_Output_File(FILE * file,
+                     size_t bytes,
+                     File_Map & map)
+{
+  map.data = 0;                       // set file size and map it for writing,
+  map.bytes = 0;                      // or return false if it is not possible
+  if (bytes == 0) return false;
+#ifdef _WIN32
+  HANDLE handle = HANDLE(_get_osfhandle(_fileno(file)));
+  if (GetFileType(handle) != FILE_TYPE_DISK) return false;
+  unsigned long long size = bytes;
+  map.mapping = CreateFileMapping(handle, 0, PAGE_READWRITE,
+                                  DWORD(size >> 32), DWORD(size), 0);
+  if (map.mapping == 0) return false;
+  map.data = (unsigned char *) MapViewOfFile(map.mapping, FILE_MAP_WRITE,
+                                             0, 0, 0);
+  if (map.data == 0) {
+    CloseHandle(map.mapping);
+    return false;
+  }
+#else
+  struct stat info;
+  if (fstat(fileno(file), &info) || !S_ISREG(info.st_mode) ||
+      (off_t(bytes) <= 0) || (size_t(off_t(bytes)) != bytes) ||
+      ftruncate(fileno(file), off_t(bytes))) return false;
+  void * view = mmap(0, bytes, PROT_READ | PROT_WRITE, MAP_SHARED,
+                     fileno(file), 0);
+  if (view == MAP_FAILED) {
+    if (ftruncate(fileno(file), 0)) Error(W_MSG);
+    return false;
+  }
+  map.data = (unsigned char *) view;
+#endif
+  map.bytes = bytes;
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void Unmap_File(File_Map & map)
+{
+  if (map.data == 0) return;
+#ifdef _WIN32
+  UnmapViewOfFile(map.data);
+  CloseHandle(map.mapping);
+#else
+  munmap(map.data, map.bytes);
+#endif
+  map.data = 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+double Seconds(void)
+{
+  return std::chrono::duration<double>(
+           std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+Block_Job * New_Block_Jobs(unsigned number_of_jobs,
+                           unsigned block_size,
+                           bool mapped_data)
+{
+  Block_Job * job = new Block_Job[number_of_jobs];
+  for (unsigned n = 0; n < number_of_jobs; n++) {
+    job[n].memory = (mapped_data ? 0 : new unsigned char[block_size]);
+    job[n].data = job[n].memory;
+    job[n].codec.set_buffer(2 * block_size + 1024);    // worst-case expansion
+  }
+  return job;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void Delete_Block_Jobs(unsigned number_of_jobs,
+                       Block_Job job[])
+{
+  for (unsigned n = 0; n < number_of_jobs; n++) delete [] job[n].memory;
+  delete [] job;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// - - Coder models implementation - - - - - - - - - - - - - - - - - - - - - -
+
+Coder_Models::Coder_Models(const Context_Options & options) :
+  bytes(options.method == PPMMethod ? 0 : options.order, // PPM has own models
+        options.method == PPMMethod ? 0 : options.bits)
+{
+  history = 0;
+  lz77 = (options.method == LZ77Method ? new LZ77_Codec : 0);
+  bwt  = (options.method == BWTMethod  ? new BWT_Codec  : 0);
+  ppm  = (options.method == PPMMethod  ?
+          new PPM_Codec(options.order, options.bits) : 0);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+Coder_Models::~Coder_Models(void)
+{
+  delete lz77;
+  delete bwt;
+  delete ppm;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void Coder_Models::reset(void)
+{
+  bytes.reset();
+  history = 0;
+  if (lz77) lz77->reset();
+  if (bwt)  bwt->reset();
+  if (ppm)  ppm->reset();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// - - Job queue implementation  - - - - - - - - - - - - - - - - - - - - - - -
 
-    encoder.start_encoder();
-    for (unsigned p = 0; p < nb; p++) {                       // compress data
-      encoder.encode(data[p], dm[context]);
-      context = unsigned(data[p]) & (NumModels - 1);
+void Job_Queue::push(Block_Job * job)
+{
+  std::lock_guard<std::mutex> lock(access);
+  jobs.push_back(job);
+  change.notify_one();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+Block_Job * Job_Queue::pop(void)
+{
+  std::unique_lock<std::mutex> lock(access);
+  while (jobs.empty() && !closed) change.wait(lock);
+  if (jobs.empty()) return 0;
+  Block_Job * job = jobs.front();
+  jobs.pop_front();
+  return job;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void Job_Queue::close(void)
+{
+  std::lock_guard<std::mutex> lock(access);
+  closed = true;
+  change.notify_all();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// - - Pipeline implementation - - - - - - - - - - - - - - - - - - - - - - - -
+
+void Block_Pipeline::run(unsigned coder_threads,
+                         unsigned number_of_jobs,
+                         unsigned block_size,
+                         bool mapped_data)
+{
+  double start = Seconds();
+  jobs = number_of_jobs;
+  coders = coder_threads;
+  bytes = 0;
+  read_time = code_time = write_time = 0;
+                                           // all jobs start in the free queue
+  Block_Job * job = New_Block_Jobs(jobs, block_size, mapped_data);
+  pending = new Block_Job * [jobs];
+  for (unsigned n = 0; n < jobs; n++) {
+    pending[n] = 0;
+    free_jobs.push(job + n);
+  }
+                                         // start stages; calling thread reads
+  std::vector<std::thread> coder_pool;
+  for (unsigned t = 0; t < coders; t++)
+    coder_pool.push_back(std::thread(&Block_Pipeline::coder, this));
+  std::thread writer_thread(&Block_Pipeline::writer, this);
+  reader();
+                                       // each stage closes the queue it fills
+  for (unsigned t = 0; t < coders; t++) coder_pool[t].join();
+  coded_jobs.close();
+  writer_thread.join();
+
+  delete [] pending;
+  Delete_Block_Jobs(jobs, job);
+  run_time = Seconds() - start;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void Block_Pipeline::reader(void)
+{
+  for (unsigned long long sequence = 0; ; sequence++) {
+    Block_Job * job = free_jobs.pop();             // waits for a reusable job
+    double start = Seconds();
+    bool more = read_block(*job);
+    read_time += Seconds() - start;
+    if (!more) break;
+    job->sequence = sequence;
+    read_jobs.push(job);
+  }
+  read_jobs.close();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void Block_Pipeline::coder(void)
+{
+  Coder_Models model(context);
+  double busy = 0;
+  for (Block_Job * job; (job = read_jobs.pop()) != 0; ) {
+    double start = Seconds();
+    code_block(*job, model);
+    busy += Seconds() - start;
+    coded_jobs.push(job);
+  }
+  std::lock_guard<std::mutex> lock(time_access);
+  code_time += busy;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void Block_Pipeline::writer(void)
+{                         // jobs in flight have different sequence % jobs, so
+  unsigned long long next = 0;    // they can wait in pending[] for their turn
+  for (Block_Job * job; (job = coded_jobs.pop()) != 0; ) {
+    pending[job->sequence%jobs] = job;
+    while ((job = pending[next%jobs]) != 0) {
+      double start = Seconds();
+      write_block(*job);
+      write_time += Seconds() - start;
+      bytes += job->bytes;
+      pending[next++%jobs] = 0;
+      free_jobs.push(job);
     }
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-    encoder.write_to_file(code_file);  // stop encoder & write compressed data
+void Block_Pipeline::report_stages(FILE * report)
+{
+  double mb = 1e-6 * double(bytes);           // rates of busy time, not waits
+  fprintf(report, " Stage throughput (MB/s): read %.1f, code %.1f "
+          "(%u thread%s), write %.1f\n",
+          (read_time > 0 ? mb / read_time : 0),
+          (code_time > 0 ? coders * mb / code_time : 0),
+          coders, (coders > 1 ? "s" : ""),
+          (write_time > 0 ? mb / write_time : 0));
+  if (context.method == PPMMethod)
+    fprintf(report, " Overall %.1f MB/s; PPM order %u, %.1f MB per thread\n",
+            (run_time > 0 ? mb / run_time : 0), context.order,
+            1e-6 * double(Context_Memory(context)));
+  else
+    fprintf(report, " Overall %.1f MB/s; %scontext order %u, %u bits: %u "
+            "models, %.1f MB per thread\n",
+            (run_time > 0 ? mb / run_time : 0),
+            (context.method == LZ77Method ? "LZ77 matches, literal " :
+             (context.method == BWTMethod ? "BWT + MTF, rank " : "")),
+            context.order, context.bits, 1U << context.bits,
+            1e-6 * double(Context_Memory(context)));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// - - Block encoder and decoder - - - - - - - - - - - - - - - - - - - - - - -
+
+Block_Encoder::Block_Encoder(FILE * _data_file,
+                             FILE * _code_file,
+                             const File_Map & _map,
+                             unsigned _block_size,
+                             const Context_Options & _context,
+                             unsigned header_bytes) :
+  Block_Pipeline(_context), map(_map)
+{
+  data_file  = _data_file;
+  code_file  = _code_file;
+  block_size = _block_size;
+  data_bytes = 0;
+  code_bytes = header_bytes;                        // file header comes first
+  crc = 0;
+  end_of_data = false;
+}
 
-  } while (bytes -= nb);
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-                                                          // done: close files
-  fflush(code_file);
-  unsigned data_bytes = ftell(data_file), code_bytes = ftell(code_file);
-  printf(" Compressed file size = %d bytes (%6.2f:1 compression)\n",
-    code_bytes, double(data_bytes) / double(code_bytes));
-  fclose(data_file);
-  fclose(code_file);
+bool Block_Encoder::read_block(Block_Job & job)
+{
+  if (end_of_data) return false;
 
-  delete [] data;
+  if (map.data) {                       // point to data in memory-mapped file
+    size_t left = map.bytes - size_t(data_bytes);
+    job.bytes = unsigned(left < block_size ? left : block_size);
+    job.data = map.data + size_t(data_bytes);
+  }
+  else {
+    job.bytes = unsigned(fread(job.data, 1, block_size, data_file));
+    if (ferror(data_file)) Error(R_MSG);
+  }
+  end_of_data = (job.bytes < block_size);
+  data_bytes += job.bytes;
+  return (job.bytes > 0);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-void Decode_File(char * code_file_name,
-                 char * data_file_name)
+void Block_Encoder::code_block(Block_Job & job,
+                               Coder_Models & model)
 {
-                                                                 // open files
-  FILE * code_file = Open_Input_File(code_file_name);
-  FILE * data_file  = Open_Output_File(data_file_name);
+  model.reset();                          // each block starts with new models
+
+  job.crc = CRC32C(job.bytes, job.data);
+
+  job.stored = Incompressible(job.bytes, job.data);
+  if (!job.stored) {
+    job.codec.start_encoder();
+    if (model.lz77)
+      model.lz77->encode(job.codec, model.bytes, job.data, job.bytes);
+    else
+      if (model.bwt)
+        model.bwt->encode(job.codec, model.bytes, job.data, job.bytes);
+      else
+        if (model.ppm)
+          model.ppm->encode(job.codec, job.data, job.bytes);
+        else {
+          unsigned history = 0;
+          for (unsigned p = 0; p < job.bytes; p++) {          // compress data
+            job.codec.encode(job.data[p], model[history]);
+            history = (history << 8) | job.data[p];
+          }
+        }
+    job.code_bytes = job.codec.stop_encoder();
+    job.stored = (job.code_bytes >= job.bytes);      // coding did not pay off
+  }
+  if (job.stored) job.code_bytes = job.bytes;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void Block_Encoder::write_block(Block_Job & job)
+{
+  unsigned char header[8];                     // data & code sizes, then code
+  Save_Number(job.bytes, header);
+  Save_Number(job.code_bytes | (job.stored ? StoredBlock : 0), header + 4);
+  unsigned char * code = (job.stored ? job.data : job.codec.buffer());
+  if ((fwrite(header, 1, 8, code_file) != 8) ||
+      (fwrite(code, 1, job.code_bytes, code_file) != job.code_bytes))
+    Error(W_MSG);
+
+  Block_Entry entry;                  // all blocks but the last are full size
+  entry.code_offset = code_bytes;
+  entry.data_offset = index.size() * (unsigned long long)(block_size);
+  entry.crc = job.crc;
+  index.push_back(entry);
+
+  crc ^= job.crc;
+  code_bytes += 8 + job.code_bytes;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+Block_Decoder::Block_Decoder(FILE * _code_file,
+                             FILE * _data_file,
+                             const File_Map & _map,
+                             unsigned _block_size,
+                             const Context_Options & _context,
+                             unsigned header_bytes,
+                             bool _crc32c) :
+  Block_Pipeline(_context), map(_map)
+{
+  code_file  = _code_file;
+  data_file  = _data_file;
+  block_size = _block_size;
+  crc32c     = _crc32c;
+  data_bytes = 0;
+  code_bytes = header_bytes;
+  crc = 0;
+  end_of_data = false;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+bool Block_Decoder::read_block(Block_Job & job)
+{
+  if (end_of_data) return false;
+
+  unsigned char header[8];
+  if (fread(header, 1, 4, code_file) != 4) Error(R_MSG);
+  if ((job.bytes = Recover_Number(header)) == 0) {   // end mark: 0-byte block
+    end_of_data = true;
+    return false;
+  }
+  if (fread(header + 4, 1, 4, code_file) != 4) Error(R_MSG);
+  job.code_bytes = Recover_Number(header + 4) & ~StoredBlock;
+  job.stored = (Recover_Number(header + 4) & StoredBlock) != 0;
+  if ((job.bytes > block_size) || (job.code_bytes > 2 * block_size + 1024) ||
+      (job.stored && (job.code_bytes != job.bytes)))
+    Error("invalid compressed file");
+
+  if (map.data) {                     // decode directly to memory-mapped file
+    if (job.bytes > map.bytes - data_bytes) Error("invalid compressed file");
+    job.data = map.data + size_t(data_bytes);
+  }
+  unsigned char * code = (job.stored ? job.data : job.codec.buffer());
+  if (fread(code, 1, job.code_bytes, code_file) != job.code_bytes)
+    Error(R_MSG);                           // raw data is read to final place
+  data_bytes += job.bytes;
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void Block_Decoder::code_block(Block_Job & job,
+                               Coder_Models & model)
+{
+  model.reset();                          // each block starts with new models
+
+  if (!job.stored) {
+    job.codec.start_decoder();
+    if (model.lz77)
+      model.lz77->decode(job.codec, model.bytes, job.data, job.bytes);
+    else
+      if (model.bwt)
+        model.bwt->decode(job.codec, model.bytes, job.data, job.bytes);
+      else
+        if (model.ppm)
+          model.ppm->decode(job.codec, job.data, job.bytes);
+        else {
+          unsigned history = 0;
+          for (unsigned p = 0; p < job.bytes; p++) {        // decompress data
+            job.data[p] = (unsigned char) job.codec.decode(model[history]);
+            history = (history << 8) | job.data[p];
+          }
+        }
+    job.codec.stop_decoder();
+  }
+
+  job.crc = (crc32c ? CRC32C(job.bytes, job.data) :
+                      Buffer_CRC(job.bytes, job.data));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void Block_Decoder::write_block(Block_Job & job)
+{
+  Block_Entry entry;               // to be compared with index in file footer
+  entry.code_offset = code_bytes;
+  entry.data_offset = index.size() * (unsigned long long)(block_size);
+  entry.crc = job.crc;
+  index.push_back(entry);
+
+  crc ^= job.crc;
+  code_bytes += 8 + job.code_bytes;
+  if (!map.data && (fwrite(job.data, 1, job.bytes, data_file) != job.bytes))
+    Error(W_MSG);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+Range_Decoder::Range_Decoder(FILE * _code_file,
+                             FILE * _data_file,
+                             const File_Map & _map,
+                             unsigned _block_size,
+                             const Context_Options & _context,
+                             const Block_Entry * first_entry,
+                             unsigned long long blocks,
+                             unsigned long long _first_byte,
+                             unsigned long long _end_byte) :
+  Block_Decoder(_code_file, _data_file, _map, _block_size, _context, 0, true)
+{
+  entry       = first_entry;
+  blocks_left = blocks;
+  first_byte  = _first_byte;
+  end_byte    = _end_byte;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+bool Range_Decoder::read_block(Block_Job & job)
+{
+  if (blocks_left == 0) return false;                // stop after last needed
+  blocks_left--;                                     // block, not at end mark
+  if (!Block_Decoder::read_block(job)) Error("invalid compressed file");
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-                                   // read file information from 12-byte header
+void Range_Decoder::write_block(Block_Job & job)
+{                             // each block is checked with CRC from the index
+  const Block_Entry & block = entry[job.sequence];
+  if (job.crc != block.crc) Error("incorrect block CRC");
+
+                                       // write only the part inside the range
+  unsigned long long start = block.data_offset, end = start + job.bytes;
+  if (start < first_byte) start = first_byte;
+  if (end > end_byte) end = end_byte;
+  size_t nb = size_t(end - start);
+  if (fwrite(job.data + size_t(start - block.data_offset), 1, nb, data_file)
+      != nb) Error(W_MSG);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// - - Classic encoder and decoder - - - - - - - - - - - - - - - - - - - - - -
+
+Classic_Encoder::Classic_Encoder(FILE * _data_file,
+                                 FILE * _code_file,
+                                 const File_Map & _map,
+                                 const Context_Options & _context) :
+  Block_Pipeline(_context), map(_map)
+{
+  data_file = _data_file;
+  code_file = _code_file;
+  code_bytes = 0;
+  data_bytes = crc = 0;
+  end_of_data = false;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+bool Classic_Encoder::read_block(Block_Job & job)
+{
+  if (end_of_data) return false;
+
+  if (map.data) {                                            // read file data
+    size_t left = map.bytes - data_bytes;
+    job.bytes = unsigned(left < BufferSize ? left : BufferSize);
+    job.data = map.data + data_bytes;
+  }
+  else {
+    job.bytes = unsigned(fread(job.data, 1, BufferSize, data_file));
+    if (ferror(data_file)) Error(R_MSG);
+  }
+  end_of_data = (job.bytes < BufferSize);
+  if ((job.bytes == 0) && (data_bytes > 0)) return false;  // ended last block
+  if (job.bytes > 0xFFFFFFFFU - data_bytes) Error("file is too large");
+  data_bytes += job.bytes;
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void Classic_Encoder::code_block(Block_Job & job,
+                                 Coder_Models & model)
+{                           // single coder thread: blocks are coded in order,
+  crc = CRC32C(job.bytes, job.data, crc);          // with models carried over
+
+  job.codec.start_encoder();
+  unsigned history = model.history;          // local copy stays in a register
+  for (unsigned p = 0; p < job.bytes; p++) {                  // compress data
+    job.codec.encode(job.data[p], model[history]);
+    history = (history << 8) | job.data[p];
+  }
+  model.history = history;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void Classic_Encoder::write_block(Block_Job & job)
+{                                      // stop encoder & write compressed data
+  code_bytes += job.codec.write_to_file(code_file);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+Classic_Decoder::Classic_Decoder(FILE * _code_file,
+                                 FILE * _data_file,
+                                 const File_Map & _map,
+                                 const Context_Options & _context,
+                                 unsigned _data_bytes,
+                                 bool _crc32c) :
+  Block_Pipeline(_context), map(_map)
+{
+  code_file = _code_file;
+  data_file = _data_file;
+  bytes_left = _data_bytes;
+  crc32c = _crc32c;
+  crc = 0;
+  end_of_data = false;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+bool Classic_Decoder::read_block(Block_Job & job)
+{
+  if (end_of_data) return false;
+
+  job.codec.read_from_file(code_file); // read compressed data & start decoder
+
+  job.bytes = (bytes_left < BufferSize ? bytes_left : BufferSize);
+  if (map.data) job.data = map.data + (map.bytes - bytes_left);
+  end_of_data = ((bytes_left -= job.bytes) == 0);
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void Classic_Decoder::code_block(Block_Job & job,
+                                 Coder_Models & model)
+{
+  unsigned history = model.history;          // local copy stays in a register
+  for (unsigned p = 0; p < job.bytes; p++) {                // decompress data
+    job.data[p] = (unsigned char) job.codec.decode(model[history]);
+    history = (history << 8) | job.data[p];
+  }
+  model.history = history;
+  job.codec.stop_decoder();
+
+  if (crc32c)                                       // compute CRC of new file
+    crc = CRC32C(job.bytes, job.data, crc);
+  else
+    crc ^= Buffer_CRC(job.bytes, job.data);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void Classic_Decoder::write_block(Block_Job & job)
+{
+  if (!map.data && (fwrite(job.data, 1, job.bytes, data_file) != job.bytes))
+    Error(W_MSG);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// - - File coding functions - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void Encode_Classic(FILE * data_file,
+                    FILE * code_file,
+                    const Context_Options & context,
+                    bool verbose)
+{
+  File_Map map;                    // code directly from memory if file mapped
+  if (Map_Input_File(data_file, map) && (map.bytes > 0xFFFFFFFFU))
+    Error("file is too large");
+
+                       // space for 12-byte header, completed after the coding
+  unsigned char header[16];                 // (+ context word if not default)
+  bool context_word = !Default_Context(context);
+  unsigned header_bytes = (context_word ? 16 : 12);
+  Save_Number(FILE_ID | CRC32C_ID | (context_word ? CONTEXT_ID : 0), header);
+  Save_Number(0,       header + 4);
+  Save_Number(0,       header + 8);
+  Save_Number(Context_Word(context), header + 12);
+  if (fwrite(header, 1, header_bytes, code_file) != header_bytes)
+    Error(W_MSG);
+
+                 // single pass: CRC (cyclic check) computed while coding file
+  Classic_Encoder encoder(data_file, code_file, map, context);
+  encoder.run(1, ClassicJobs, BufferSize, map.data != 0);
+                                                       // complete file header
+  Save_Number(encoder.crc,        header + 4);
+  Save_Number(encoder.data_bytes, header + 8);
+  if (fseek(code_file, 4, SEEK_SET)) Error("cannot seek in output file");
+  if (fwrite(header + 4, 1, 8, code_file) != 8) Error(W_MSG);
+  fseek(code_file, 0, SEEK_END);
+
+  Report_Size(code_file, encoder.data_bytes,
+              header_bytes + encoder.code_bytes);
+  if (verbose) encoder.report_stages(Report_Stream(code_file));
+  Unmap_File(map);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void Encode_Blocks(FILE * data_file,
+                   FILE * code_file,
+                   unsigned block_KB,
+                   unsigned threads,
+                   const Context_Options & context,
+                   bool verbose)
+{
+  File_Map map;                    // code directly from memory if file mapped
+  Map_Input_File(data_file, map);
+
+  unsigned block_size = block_KB << 10;
+                                      // 8-byte header: file ID and block size
+  unsigned char header[12];                 // (+ context word if not default)
+  bool context_word = !Default_Context(context);
+  unsigned header_bytes = (context_word ? 12 : 8);
+  Save_Number(BLOCK_ID | CRC32C_ID | INDEX_ID |
+              (context_word ? CONTEXT_ID : 0),         header);
+  Save_Number(block_size,                              header + 4);
+  Save_Number(Context_Word(context),                   header + 8);
+  if (fwrite(header, 1, header_bytes, code_file) != header_bytes)
+    Error(W_MSG);
+
+  Block_Encoder encoder(data_file, code_file, map, block_size, context,
+                        header_bytes);
+  encoder.run(threads, threads * BlocksPerThread, block_size, map.data != 0);
+
+           // footer: end mark, block index, number of blocks, CRC, file size;
+                           // file ends with 20 bytes needed to find the index
+  size_t blocks = encoder.index.size(), footer_bytes = 20 * blocks + 24;
+  unsigned char * footer = new unsigned char[footer_bytes];
+  Save_Number(0, footer);
+  for (size_t n = 0; n < blocks; n++)
+    Save_Entry(encoder.index[n], footer + 4 + 20 * n);
+  Save_Number64(blocks,             footer + footer_bytes - 20);
+  Save_Number(encoder.crc,          footer + footer_bytes - 12);
+  Save_Number64(encoder.data_bytes, footer + footer_bytes - 8);
+  if (fwrite(footer, 1, footer_bytes, code_file) != footer_bytes)
+    Error(W_MSG);
+  delete [] footer;
+
+  Report_Size(code_file, encoder.data_bytes, encoder.code_bytes+footer_bytes);
+  if (verbose) encoder.report_stages(Report_Stream(code_file));
+  Unmap_File(map);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void Decode_Classic(FILE * code_file,
+                    FILE * data_file,
+                    unsigned id_flags,
+                    bool verbose)
+{
+                          // read file information from rest of 12-byte header
+  unsigned char header[8];
+  if (fread(header, 1, 8, code_file) != 8) Error(R_MSG);
+  unsigned crc   = Recover_Number(header);
+  unsigned bytes = Recover_Number(header + 4);
+  Context_Options context = Read_Context(code_file, id_flags);
+  if (context.method != ContextMethod) Error("invalid compressed file");
+
+  File_Map map;                       // decode directly to memory if possible
+  Map_Output_File(data_file, bytes, map);
+
+  Classic_Decoder decoder(code_file, data_file, map, context, bytes,
+                          (id_flags & CRC32C_ID) != 0);
+  decoder.run(1, ClassicJobs, BufferSize, map.data != 0);
+
+  if (verbose) decoder.report_stages(Report_Stream(data_file));
+  Unmap_File(map);
+                                                   // check if file is correct
+  if (crc != decoder.crc) Error("incorrect file CRC");
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void Decode_Blocks(FILE * code_file,
+                   FILE * data_file,
+                   unsigned id_flags,
+                   unsigned threads,
+                   bool verbose)
+{
+                                         // read block size from 8-byte header
   unsigned char header[12];
+  if (fread(header, 1, 4, code_file) != 4) Error(R_MSG);
+  unsigned block_size = Recover_Number(header);
+  if ((block_size < 4096) || (block_size > (MaxBlockKB << 10)))
+    Error("invalid compressed file");
+  Context_Options context = Read_Context(code_file, id_flags);
+  unsigned header_bytes = (id_flags & CONTEXT_ID ? 12 : 8);
+
+                       // if file size can be read from trailer, decode blocks
+  File_Map map;                          // directly to memory-mapped new file
+  map.data = 0;
+  map.bytes = 0;
+  unsigned long long file_bytes;
+  if (Regular_File_Size(code_file, file_bytes) && (file_bytes >= 24) &&
+      (fseek(code_file, -8, SEEK_END) == 0)) {
+    if (fread(header, 1, 8, code_file) != 8) Error(R_MSG);
+    unsigned long long data_bytes = Recover_Number64(header);
+    if (!Seek_File(code_file, header_bytes)) Error(R_MSG);
+    if ((unsigned long long)(size_t(data_bytes)) == data_bytes)
+      Map_Output_File(data_file, size_t(data_bytes), map);
+  }
+
+  Block_Decoder decoder(code_file, data_file, map, block_size, context,
+                        header_bytes, (id_flags & CRC32C_ID) != 0);
+  decoder.run(threads, threads * BlocksPerThread, block_size, map.data != 0);
+
+  if (id_flags & INDEX_ID) {          // block index must match decoded blocks
+    unsigned char entry[20];
+    Block_Entry block;
+    for (size_t n = 0; n < decoder.index.size(); n++) {
+      if (fread(entry, 1, 20, code_file) != 20) Error(R_MSG);
+      Recover_Entry(entry, block);
+      if ((block.code_offset != decoder.index[n].code_offset) ||
+          (block.data_offset != decoder.index[n].data_offset) ||
+          (block.crc != decoder.index[n].crc))
+        Error("invalid compressed file");
+    }
+    if (fread(entry, 1, 8, code_file) != 8) Error(R_MSG);
+    if (Recover_Number64(entry) != decoder.index.size())
+      Error("invalid compressed file");
+  }
+                                          // rest of footer: CRC and file size
   if (fread(header, 1, 12, code_file) != 12) Error(R_MSG);
-  unsigned fid   = Recover_Number(header);
-  unsigned crc   = Recover_Number(header + 4);
-  unsigned bytes = Recover_Number(header + 8);
+  if ((Recover_Number64(header + 4) != decoder.data_bytes) ||
+      (map.data && (map.bytes != decoder.data_bytes)))
+    Error("invalid compressed file");
 
-  if (fid != FILE_ID) Error("invalid compressed file");
+  if (verbose) decoder.report_stages(Report_Stream(data_file));
+  Unmap_File(map);
+                                                   // check if file is correct
+  if (Recover_Number(header) != decoder.crc) Error("incorrect file CRC");
+}
 
-                                                  // buffer for data file data
-  unsigned char * data = new unsigned char[BufferSize];
-                                                            // set data models
-  Adaptive_Data_Model dm[NumModels];
-  for (unsigned m = 0; m < NumModels; m++) dm[m].set_alphabet(256);
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-  Arithmetic_Codec decoder(BufferSize);                  // set encoder buffer
+void Decode_Range(FILE * code_file,
+                  FILE * data_file,
+                  unsigned id_flags,
+                  unsigned long long first_byte,
+                  unsigned long long range_bytes,
+                  unsigned threads,
+                  bool verbose)
+{
+                                         // read block size from 8-byte header
+  unsigned char header[20];
+  if (fread(header, 1, 4, code_file) != 4) Error(R_MSG);
+  unsigned block_size = Recover_Number(header);
+  if ((block_size < 4096) || (block_size > (MaxBlockKB << 10)))
+    Error("invalid compressed file");
+  Context_Options context = Read_Context(code_file, id_flags);
+  unsigned header_bytes = (id_flags & CONTEXT_ID ? 12 : 8);
+
+              // last 20 bytes: number of blocks, CRC, file size; index before
+  unsigned long long file_bytes;
+  if (!Regular_File_Size(code_file, file_bytes))
+    Error("range decoding needs a regular compressed file");
+  if ((file_bytes < 32) || !Seek_File(code_file, file_bytes - 20))
+    Error("invalid compressed file");
+  if (fread(header, 1, 20, code_file) != 20) Error(R_MSG);
+  unsigned long long blocks = Recover_Number64(header);
+  unsigned long long data_bytes = Recover_Number64(header + 12);
+  if ((blocks > (file_bytes - 32) / 28) ||
+      (data_bytes > blocks * (unsigned long long)(block_size)) ||
+      (data_bytes + block_size <= blocks * (unsigned long long)(block_size)))
+    Error("invalid compressed file");
+                                                         // clip range to file
+  if (first_byte > data_bytes) Error("range starts after end of file");
+  if (range_bytes > data_bytes - first_byte)
+    range_bytes = data_bytes - first_byte;
+  unsigned long long end_byte = first_byte + range_bytes;
+
+                                      // read index entries of blocks in range
+  unsigned long long first_block = first_byte / block_size;
+  unsigned long long end_block = first_block;
+  if (range_bytes) end_block = (end_byte - 1) / block_size + 1;
+  size_t number_of_blocks = size_t(end_block - first_block);
+  std::vector<Block_Entry> entry(number_of_blocks);
+  unsigned long long index_start = file_bytes - 20 - 20 * blocks;
+  if (!Seek_File(code_file, index_start + 20 * first_block))
+    Error("invalid compressed file");
+  for (size_t n = 0; n < number_of_blocks; n++) {
+    if (fread(header, 1, 20, code_file) != 20) Error(R_MSG);
+    Recover_Entry(header, entry[n]);
+    if ((entry[n].data_offset != (first_block + n) * block_size) ||
+        (entry[n].code_offset < header_bytes) ||
+        (entry[n].code_offset >= index_start))
+      Error("invalid compressed file");
+  }
 
-  unsigned nb, new_crc = 0, context = 0;                    // decompress file
-  do {
+  if (number_of_blocks > 0) {       // decode needed blocks, in their sequence
+    if (!Seek_File(code_file, entry[0].code_offset)) Error(R_MSG);
+    File_Map map;
+    map.data = 0;
+    map.bytes = 0;
+    Range_Decoder decoder(code_file, data_file, map, block_size, context,
+                          &entry[0], number_of_blocks, first_byte, end_byte);
+    decoder.run(threads, threads * BlocksPerThread, block_size, false);
+    if (verbose) decoder.report_stages(Report_Stream(data_file));
+  }
+}
 
-    decoder.read_from_file(code_file); // read compressed data & start decoder
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-    nb = (bytes < BufferSize ? bytes : BufferSize);
-                                                            // decompress data
-    for (unsigned p = 0; p < nb; p++) {
-      data[p] = (unsigned char) decoder.decode(dm[context]);
-      context = unsigned(data[p]) & (NumModels - 1);
-    }
-    decoder.stop_decoder();
+void Encode_File(char * data_file_name,
+                 char * code_file_name,
+                 const Coding_Options & options)
+{
+                                                                 // open files
+  FILE * data_file = Open_Input_File(data_file_name);
+  FILE * code_file = Open_Output_File(code_file_name, options.force,
+                                      data_file == stdin);
+
+        // classic format needs a seekable output, and stores 32-bit file size
+  unsigned long long data_bytes, code_bytes;
+  if ((options.threads == 0) && (options.block_KB == 0) &&
+      !options.seekable && (options.context.method == ContextMethod) &&
+      Regular_File_Size(data_file, data_bytes) &&
+      (data_bytes <= 0xFFFFFFFFU) && Regular_File_Size(code_file, code_bytes))
+    Encode_Classic(data_file, code_file, options.context, options.verbose);
+  else
+    Encode_Blocks(data_file, code_file,
+                  (options.block_KB ? options.block_KB : DefaultBlockKB),
+                  Number_of_Threads(options), options.context,
+                  options.verbose);
 
-    new_crc ^= Buffer_CRC(nb, data);                // compute CRC of new file
-    if (fwrite(data, 1, nb, data_file) != nb) Error(W_MSG);
+                                                          // done: close files
+  if (fclose(code_file)) Error(W_MSG);
+  fclose(data_file);
+}
 
-  } while (bytes -= nb);
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+void Decode_File(char * code_file_name,
+                 char * data_file_name,
+                 const Coding_Options & options)
+{
+                                   // open compressed file and identify format
+  FILE * code_file = Open_Input_File(code_file_name);
+  unsigned char header[4];
+  if (fread(header, 1, 4, code_file) != 4) Error(R_MSG);
+  unsigned flags = Recover_Number(header) & (CRC32C_ID|INDEX_ID|CONTEXT_ID);
+  unsigned fid = Recover_Number(header) & ~flags;
+  if ((fid != BLOCK_ID) && ((fid != FILE_ID) || (flags & INDEX_ID)))
+    Error("invalid compressed file");
+  if (options.range && !(flags & INDEX_ID))
+    Error("file has no block index (compress with -s)");
+
+  FILE * data_file = Open_Output_File(data_file_name, options.force,
+                                      code_file == stdin);
+
+  if (options.range)
+    Decode_Range(code_file, data_file, flags, options.first_byte,
+                 options.range_bytes, Number_of_Threads(options),
+                 options.verbose);
+  else
+    if (fid == FILE_ID)
+      Decode_Classic(code_file, data_file, flags, options.verbose);
+    else
+      Decode_Blocks(code_file, data_file, flags, Number_of_Threads(options),
+                    options.verbose);
 
-  fclose(data_file);                                     // done: close files
+                                                          // done: close files
+  if (fclose(data_file)) Error(W_MSG);
   fclose(code_file);
-
-  delete [] data;
-                                                   // check if file is correct
-  if (crc != new_crc) Error("incorrect file CRC");
 }
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
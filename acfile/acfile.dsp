@@ -95,6 +95,26 @@ SOURCE=.\acfile.cpp
 
 SOURCE=..\arithmetic_codec.cpp
 # End Source File
+# Begin Source File
+
+SOURCE=..\bwt_codec.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=..\checksum.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=..\context_model.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=..\lz77_codec.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=..\ppm_codec.cpp
+# End Source File
 # End Group
 # Begin Group "Header Files"
 
@@ -103,6 +123,26 @@ SOURCE=..\arithmetic_codec.cpp
 
 SOURCE=..\arithmetic_codec.h
 # End Source File
+# Begin Source File
+
+SOURCE=..\bwt_codec.h
+# End Source File
+# Begin Source File
+
+SOURCE=..\checksum.h
+# End Source File
+# Begin Source File
+
+SOURCE=..\context_model.h
+# End Source File
+# Begin Source File
+
+SOURCE=..\lz77_codec.h
+# End Source File
+# Begin Source File
+
+SOURCE=..\ppm_codec.h
+# End Source File
 # End Group
 # Begin Group "Resource Files"
 
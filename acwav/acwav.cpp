@@ -37,6 +37,7 @@
 #include <stdlib.h>
 
 #include "arithmetic_codec.h"
+#include "checksum.h"
 
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -86,6 +87,8 @@ const unsigned WAV_ID     = 0x46464952U;
 
 const unsigned ACW_ID     = 0xF3C2047BU;
 
+const unsigned CRC32C_ID  = 0x00000004U;      // ACW flag: CRC32C, not old CRC
+
 const unsigned char WAVE_HEADER[44] = {
   0x52, 0x49, 0x46, 0x46, 0x7F, 0x7F, 0x7F, 0x7F, 0x57, 0x41, 0x56,
   0x45, 0x66, 0x6D, 0x74, 0x20, 0x10, 0x00, 0x00, 0x00, 0x01, 0x00,
@@ -160,32 +163,6 @@ int Restore_Integer(unsigned bits, unsigned data)
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-unsigned Buffer_CRC(unsigned bytes,
-                    unsigned char * buffer)
-{
-  static const unsigned CRC_Gen[8] = {        // data for generating CRC table
-    0xEC1A5A3EU, 0x5975F5D7U, 0xB2EBEBAEU, 0xE49696F7U,
-    0x486C6C45U, 0x90D8D88AU, 0xA0F0F0BFU, 0xC0A0A0D5U };
-
-  static unsigned CRC_Table[256];            // table for fast CRC computation
-
-  if (CRC_Table[1] == 0)                                      // compute table
-    for (unsigned k = CRC_Table[0] = 0; k < 8; k++) {
-      unsigned s = 1 << k, g = CRC_Gen[k];
-      for (unsigned n = 0; n < s; n++) CRC_Table[n+s] = CRC_Table[n] ^ g;
-    }
-
-                                  // computes buffer's cyclic redundancy check
-  unsigned crc = 0;
-  if (bytes)
-    do {
-      crc = (crc >> 8) ^ CRC_Table[(crc&0xFFU)^unsigned(*buffer++)];
-    } while (--bytes);
-  return crc;
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-
 void SpP_Analysis(unsigned n, int * c, int * l, int * h)
 {
                       // computation of the forward (reversible) S+P transform
@@ -344,14 +321,15 @@ void Decode_SpP(unsigned dim,
 
 FILE * Open_Input_File(unsigned file_id,
                        char * file_name,
-                       unsigned char header[44])
+                       unsigned char header[44],
+                       unsigned id_flags = 0)
 {
   FILE * new_file = fopen(file_name, "rb");
   if (new_file == 0) Error("cannot open input file");
 
   if (fread(header, 1, 44, new_file) != 44) Error(R_MSG);
 
-  if (Recover_Number(header) != file_id)
+  if ((Recover_Number(header) & ~id_flags) != file_id)
     Error("invalid input file");
 
   for (unsigned n = 4; n < 44; n++)
@@ -398,7 +376,8 @@ void Encode_WAV_File(char * data_file_name,
   if ((file_samples < 64) || (file_samples >= 0x10000000U))
     Error("invalid WAV file");
 
-  FILE * code_file = Open_Output_File(ACW_ID, code_file_name, header);
+  FILE * code_file = Open_Output_File(ACW_ID | CRC32C_ID, code_file_name,
+                                      header);
 
                                                       // memory for audio data
   int * data = new int[3*BufferSize];
@@ -418,7 +397,7 @@ void Encode_WAV_File(char * data_file_name,
     file_samples -= ns;
     if (fread(data, 4, ns, data_file) != ns) Error(R_MSG);       // read audio
 
-    crc ^= Buffer_CRC(4 * ns, (unsigned char *) data);          // compute CRC
+    crc = CRC32C(4 * ns, (unsigned char *) data, crc);          // compute CRC
     Separate_Channels(ns, es, (short*) data, left_channel, right_channel);
 
     SpP_Analysis(es, left_channel, data);                // compute transforms
@@ -455,7 +434,9 @@ void Decode_WAV_File(char * code_file_name,
 {
                                                                  // open files
   unsigned char header[44];
-  FILE * code_file = Open_Input_File(ACW_ID, code_file_name, header);
+  FILE * code_file = Open_Input_File(ACW_ID, code_file_name, header,
+                                     CRC32C_ID);
+  bool crc32c = (Recover_Number(header) & CRC32C_ID) != 0;
   FILE * data_file = Open_Output_File(WAV_ID, data_file_name, header);
   unsigned file_samples = Audio_Samples(header);
 
@@ -488,7 +469,10 @@ void Decode_WAV_File(char * code_file_name,
 
     Interleave_Channels(ns, left_channel, right_channel, (short*) data);
 
-    crc ^= Buffer_CRC(4 * ns, (unsigned char *) data);          // compute CRC
+    if (crc32c)                                                 // compute CRC
+      crc = CRC32C(4 * ns, (unsigned char *) data, crc);
+    else
+      crc ^= Buffer_CRC(4 * ns, (unsigned char *) data);
 
     if (fwrite(data, 4, ns, data_file) != ns) Error(W_MSG);      // read audio
 
@@ -95,6 +95,10 @@ SOURCE=.\acwav.cpp
 
 SOURCE=..\arithmetic_codec.cpp
 # End Source File
+# Begin Source File
+
+SOURCE=..\checksum.cpp
+# End Source File
 # End Group
 # Begin Group "Header Files"
 
@@ -103,6 +107,10 @@ SOURCE=..\arithmetic_codec.cpp
 
 SOURCE=..\arithmetic_codec.h
 # End Source File
+# Begin Source File
+
+SOURCE=..\checksum.h
+# End Source File
 # End Group
 # Begin Group "Resource Files"
 
@@ -45,21 +45,69 @@
 // - - Inclusion - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
 #include <stdlib.h>
+#include <string.h>
 #include "arithmetic_codec.h"
 
+#if defined(_MSC_VER) && (_MSC_VER >= 1400)
+#include <intrin.h>
+#endif
+
 
 // - - Constants - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
 const unsigned AC__MinLength = 0x01000000U;   // threshold for renormalization
 const unsigned AC__MaxLength = 0xFFFFFFFFU;      // maximum AC interval length
+const unsigned AC__MinCopy   = 16;       // raw bytes copied without AC coding
 
-                                           // Maximum values for binary models
+                        // Precision of binary models: default and valid range
 const unsigned BM__LengthShift = 13;     // length bits discarded before mult.
-const unsigned BM__MaxCount    = 1 << BM__LengthShift;  // for adaptive models
+const unsigned BM__MinShift    = 8;      // adaptive models halve their counts
+const unsigned BM__MaxShift    = 16;           // when these reach 2^precision
 
-                                          // Maximum values for general models
+                       // Precision of general models: default and valid range
 const unsigned DM__LengthShift = 15;     // length bits discarded before mult.
-const unsigned DM__MaxCount    = 1 << DM__LengthShift;  // for adaptive models
+const unsigned DM__MaxCount    = 1 << DM__LengthShift;    // for sparse models
+const unsigned DM__MinShift    = 10;     // adaptive models: at most 2^(# - 4)
+const unsigned DM__MaxShift    = 16;              // symbols, as 2^11 for 2^15
+
+                                           // Maximum values for sparse models
+const unsigned SM__MaxSymbols  = 1 << 16;             // nominal alphabet size
+const unsigned SM__MaxUsed     = (1 << 11) - 1;   // symbols with own estimate
+
+                                          // Maximum values for integer models
+const unsigned IM__Classes     = 33;       // magnitude classes: 0, 1, ..., 32
+const unsigned IM__MaxBits     = 8;          // adaptively coded mantissa bits
+const unsigned IM__RawBits     = 16;        // raw bits written per put_bits()
+
+                                 // Maximum total of counts in coded intervals
+const unsigned IC__MaxTotal    = 1 << 16;
+
+                                      // Estimated costs are in 1/256 of a bit
+const unsigned CE__FractionBits = 8;
+                                   // 256 log2(1 + m/256), for m = 0, ..., 255
+static const unsigned char CE__Log2_Fraction[256] = {
+    0,   1,   3,   4,   6,   7,   9,  10,  11,  13,  14,  16,
+   17,  18,  20,  21,  22,  24,  25,  26,  28,  29,  30,  32,
+   33,  34,  36,  37,  38,  40,  41,  42,  44,  45,  46,  47,
+   49,  50,  51,  52,  54,  55,  56,  57,  59,  60,  61,  62,
+   63,  65,  66,  67,  68,  69,  71,  72,  73,  74,  75,  77,
+   78,  79,  80,  81,  82,  84,  85,  86,  87,  88,  89,  90,
+   92,  93,  94,  95,  96,  97,  98,  99, 100, 102, 103, 104,
+  105, 106, 107, 108, 109, 110, 111, 112, 113, 114, 116, 117,
+  118, 119, 120, 121, 122, 123, 124, 125, 126, 127, 128, 129,
+  130, 131, 132, 133, 134, 135, 136, 137, 138, 139, 140, 141,
+  142, 143, 144, 145, 146, 147, 148, 149, 150, 151, 152, 153,
+  154, 155, 155, 156, 157, 158, 159, 160, 161, 162, 163, 164,
+  165, 166, 167, 168, 169, 169, 170, 171, 172, 173, 174, 175,
+  176, 177, 178, 178, 179, 180, 181, 182, 183, 184, 185, 185,
+  186, 187, 188, 189, 190, 191, 192, 192, 193, 194, 195, 196,
+  197, 198, 198, 199, 200, 201, 202, 203, 203, 204, 205, 206,
+  207, 208, 208, 209, 210, 211, 212, 212, 213, 214, 215, 216,
+  216, 217, 218, 219, 220, 220, 221, 222, 223, 224, 224, 225,
+  226, 227, 228, 228, 229, 230, 231, 231, 232, 233, 234, 234,
+  235, 236, 237, 238, 238, 239, 240, 241, 241, 242, 243, 244,
+  244, 245, 246, 247, 247, 248, 249, 249, 250, 251, 252, 252,
+  253, 254, 255, 255 };
 
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -73,6 +121,109 @@ static void AC_Error(const char * msg)
   exit(1);
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+static inline unsigned AC_Bit_Length(unsigned a)     // 0 for a = 0, otherwise
+{                                           // 1 + index of most significant 1
+#if defined(__GNUC__)
+  return (a ? 32 - unsigned(__builtin_clz(a)) : 0);
+#elif defined(_MSC_VER) && (_MSC_VER >= 1400)
+  unsigned long k;
+  return (_BitScanReverse(&k, a) ? unsigned(k) + 1 : 0);
+#else
+  unsigned n = 0;
+  if (a >= 0x10000U) { a >>= 16;  n += 16; }
+  if (a >= 0x100U)   { a >>= 8;   n += 8; }
+  if (a >= 0x10U)    { a >>= 4;   n += 4; }
+  if (a >= 0x4U)     { a >>= 2;   n += 2; }
+  return n + (a >= 2 ? 2 : a);
+#endif
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+static inline unsigned AC_Leading_Zeros(unsigned a)      // a must be nonzero
+{
+#if defined(__GNUC__)
+  return unsigned(__builtin_clz(a));
+#else
+  return 32 - AC_Bit_Length(a);
+#endif
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+static inline unsigned CE_Log2(unsigned a)       // 256 log2(a), a must be > 0
+{                                 // integer part, plus 8 bits after leading 1
+  unsigned n = AC_Bit_Length(a) - 1;
+  unsigned m = (n > CE__FractionBits ? a >> (n - CE__FractionBits) :
+                                       a << (CE__FractionBits - n));
+  return (n << CE__FractionBits) + CE__Log2_Fraction[m&0xFFU];
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+static inline unsigned CE_Data_Cost(const unsigned * distribution,
+                                    unsigned data,
+                                    unsigned last_symbol,
+                                    unsigned length_shift)
+{                       // -256 log2(p), from the interval used by the encoder
+  unsigned p = (data == last_symbol ? 1U << length_shift :
+                distribution[data+1]) - distribution[data];
+  return (length_shift << CE__FractionBits) - CE_Log2(p + (p == 0));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+static inline unsigned AC_Load_Word(const unsigned char * p)
+{                                  // unaligned load of big-endian 32-bit word
+#if defined(__GNUC__) || (defined(_MSC_VER) && (_MSC_VER >= 1400))
+  unsigned w;
+  memcpy(&w, p, 4);
+#if defined(__GNUC__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+  return w;
+#elif defined(__GNUC__)
+  return __builtin_bswap32(w);
+#else
+  return _byteswap_ulong(w);
+#endif
+#else
+  return (unsigned(p[0]) << 24) | (unsigned(p[1]) << 16) |
+         (unsigned(p[2]) <<  8) |  unsigned(p[3]);
+#endif
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+static inline void AC_Store_Word(unsigned char * p, unsigned w)
+{                                 // unaligned store of big-endian 32-bit word
+#if defined(__GNUC__) || (defined(_MSC_VER) && (_MSC_VER >= 1400))
+#if defined(__GNUC__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+#elif defined(__GNUC__)
+  w = __builtin_bswap32(w);
+#else
+  w = _byteswap_ulong(w);
+#endif
+  memcpy(p, &w, 4);
+#else
+  p[0] = (unsigned char)(w >> 24);
+  p[1] = (unsigned char)(w >> 16);
+  p[2] = (unsigned char)(w >>  8);
+  p[3] = (unsigned char) w;
+#endif
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+static inline unsigned AC_Load_Tail(const unsigned char * p,
+                                    const unsigned char * end)
+{                        // 32-bit word at the end of buffer: zeros past 'end'
+  unsigned w = 0;
+  for (int k = 0; k < 4; k++) w = (w << 8) | (p + k < end ? p[k] : 0U);
+  return w;
+}
+
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 // - - Coding implementations  - - - - - - - - - - - - - - - - - - - - - - - -
@@ -88,19 +239,36 @@ inline void Arithmetic_Codec::propagate_carry(void)
 
 inline void Arithmetic_Codec::renorm_enc_interval(void)
 {
-  do {                                          // output and discard top byte
-    *ac_pointer++ = (unsigned char)(base >> 24);
-    base <<= 8;
-  } while ((length <<= 8) < AC__MinLength);        // length multiplied by 256
+                         // number of bits to shift (8, 16, or 24) from length
+  unsigned shift = AC_Leading_Zeros(length) & 0x18U;
+
+  if (ac_pointer + 4 <= code_buffer + buffer_size)
+    AC_Store_Word(ac_pointer, base);     // write 4 top bytes, keep 1, 2, or 3
+  else {                        // at the end of buffer: write only bytes kept
+    if (ac_pointer + (shift >> 3) > code_buffer + buffer_size)
+      AC_Error("code buffer overflow");
+    for (unsigned k = 0; k < (shift >> 3); k++)
+      ac_pointer[k] = (unsigned char)(base >> (24 - 8 * k));
+  }
+  ac_pointer += shift >> 3;
+  base   <<= shift;                                    // discard output bytes
+  length <<= shift;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
 inline void Arithmetic_Codec::renorm_dec_interval(void)
 {
-  do {                                          // read least-significant byte
-    value = (value << 8) | unsigned(*++ac_pointer);
-  } while ((length <<= 8) < AC__MinLength);        // length multiplied by 256
+                         // number of bits to shift (8, 16, or 24) from length
+  unsigned shift = AC_Leading_Zeros(length) & 0x18U;
+
+                                    // read 4 bytes, use only 1, 2, or 3 bytes
+  const unsigned char * end = code_buffer + buffer_size;
+  unsigned w = (ac_pointer + 5 <= end ? AC_Load_Word(ac_pointer + 1) :
+                                        AC_Load_Tail(ac_pointer + 1, end));
+  value = (value << shift) | (w >> (32 - shift));
+  ac_pointer += shift >> 3;
+  length <<= shift;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -174,6 +342,116 @@ unsigned Arithmetic_Codec::get_bits(unsigned bits)
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+void Arithmetic_Codec::put_bits32(unsigned data)
+{
+#ifdef _DEBUG
+  if (mode != 1) AC_Error("encoder not initialized");
+#endif
+                                   // two 16-bit interval shifts, 1 mult. each
+  for (unsigned shift = 32; shift; ) {
+    unsigned init_base = base;
+    base += ((data >> (shift -= 16)) & 0xFFFFU) * (length >>= 16);
+    if (init_base > base) propagate_carry();               // overflow = carry
+    if (length < AC__MinLength) renorm_enc_interval();      // renormalization
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+unsigned Arithmetic_Codec::get_bits32(void)
+{
+#ifdef _DEBUG
+  if (mode != 2) AC_Error("decoder not initialized");
+#endif
+
+  unsigned data = 0;
+  for (unsigned k = 0; k < 2; k++) {
+    unsigned s = value / (length >>= 16);      // decode symbol, change length
+    value -= length * s;                                    // update interval
+    if (length < AC__MinLength) renorm_dec_interval();      // renormalization
+    data = (data << 16) | s;
+  }
+
+  return data;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void Arithmetic_Codec::put_bits64(unsigned long long data)
+{
+  put_bits32(unsigned(data >> 32));
+  put_bits32(unsigned(data & 0xFFFFFFFFU));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+unsigned long long Arithmetic_Codec::get_bits64(void)
+{
+  unsigned long long data = get_bits32();
+  return (data << 32) | get_bits32();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void Arithmetic_Codec::put_bytes(const unsigned char * data,
+                                 unsigned bytes)
+{
+#ifdef _DEBUG
+  if (mode != 1) AC_Error("encoder not initialized");
+#endif
+
+  if (bytes < AC__MinCopy) {                   // short arrays: code as 8 bits
+    while (bytes--) put_bits(*data++, 8);
+    return;
+  }
+                       // end code segment with the same bytes as stop_encoder
+  unsigned init_base = base;
+  if (length > 2 * AC__MinLength) {
+    base  += AC__MinLength;                                     // base offset
+    length = AC__MinLength >> 1;             // set new length for 1 more byte
+  }
+  else {
+    base  += AC__MinLength >> 1;                                // base offset
+    length = AC__MinLength >> 9;            // set new length for 2 more bytes
+  }
+  if (init_base > base) propagate_carry();                 // overflow = carry
+  renorm_enc_interval();
+                                      // copy data, and start new code segment
+  if (ac_pointer + bytes > code_buffer + buffer_size)
+    AC_Error("code buffer overflow");
+  memcpy(ac_pointer, data, bytes);
+  ac_pointer += bytes;
+  base   = 0;
+  length = AC__MaxLength;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void Arithmetic_Codec::get_bytes(unsigned char * data,
+                                 unsigned bytes)
+{
+#ifdef _DEBUG
+  if (mode != 2) AC_Error("decoder not initialized");
+#endif
+
+  if (bytes < AC__MinCopy) {                   // short arrays: code as 8 bits
+    while (bytes--) *data++ = (unsigned char) get_bits(8);
+    return;
+  }
+                      // decoder already read 3 bytes after the segment's end,
+                      // which used 1 or 2 more bytes, depending on the length
+  unsigned char * p = ac_pointer - (length > 2 * AC__MinLength ? 2 : 1);
+  if (p + bytes > code_buffer + buffer_size) AC_Error("code buffer overflow");
+  memcpy(data, p, bytes);
+  p += bytes;
+                                                     // start new code segment
+  length = AC__MaxLength;
+  ac_pointer = p + 3;
+  value = AC_Load_Tail(p, code_buffer + buffer_size);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
 void Arithmetic_Codec::encode(unsigned bit,
                               Static_Bit_Model & M)
 {
@@ -181,7 +459,7 @@ void Arithmetic_Codec::encode(unsigned bit,
   if (mode != 1) AC_Error("encoder not initialized");
 #endif
 
-  unsigned x = M.bit_0_prob * (length >> BM__LengthShift);   // product l x p0
+  unsigned x = M.bit_0_prob * (length >> M.length_shift);    // product l x p0
                                                             // update interval
   if (bit == 0)
     length  = x;
@@ -203,7 +481,7 @@ unsigned Arithmetic_Codec::decode(Static_Bit_Model & M)
   if (mode != 2) AC_Error("decoder not initialized");
 #endif
 
-  unsigned x = M.bit_0_prob * (length >> BM__LengthShift);   // product l x p0
+  unsigned x = M.bit_0_prob * (length >> M.length_shift);    // product l x p0
   unsigned bit = (value >= x);                                     // decision
                                                     // update & shift interval
   if (bit == 0)
@@ -227,7 +505,7 @@ void Arithmetic_Codec::encode(unsigned bit,
   if (mode != 1) AC_Error("encoder not initialized");
 #endif
 
-  unsigned x = M.bit_0_prob * (length >> BM__LengthShift);   // product l x p0
+  unsigned x = M.bit_0_prob * (length >> M.length_shift);    // product l x p0
                                                             // update interval
   if (bit == 0) {
     length = x;
@@ -253,7 +531,7 @@ unsigned Arithmetic_Codec::decode(Adaptive_Bit_Model & M)
   if (mode != 2) AC_Error("decoder not initialized");
 #endif
 
-  unsigned x = M.bit_0_prob * (length >> BM__LengthShift);   // product l x p0
+  unsigned x = M.bit_0_prob * (length >> M.length_shift);    // product l x p0
   unsigned bit = (value >= x);                                     // decision
                                                             // update interval
   if (bit == 0) {
@@ -274,6 +552,90 @@ unsigned Arithmetic_Codec::decode(Adaptive_Bit_Model & M)
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+void Arithmetic_Codec::encode_run(unsigned bit,
+                                  unsigned run_length,
+                                  unsigned max_run,
+                                  Adaptive_Bit_Model & M)
+{
+#ifdef _DEBUG
+  if (mode != 1) AC_Error("encoder not initialized");
+  if (run_length > max_run) AC_Error("invalid run length");
+#endif
+
+  bool terminated = (run_length < max_run);
+  unsigned shift = M.length_shift;
+
+  while (run_length) {     // model is constant until the next periodic update
+    unsigned n = M.bits_until_update, p = M.bit_0_prob;
+    if (n > run_length) n = run_length;
+    run_length -= n;
+    M.bits_until_update -= n;
+    if (bit == 0) {
+      M.bit_0_count += n;
+      do {                                   // bit 0: keep bottom of interval
+        length = p * (length >> shift);
+        if (length < AC__MinLength) renorm_enc_interval();
+      } while (--n);
+    }
+    else
+      do {                                      // bit 1: keep top of interval
+        unsigned init_base = base, x = p * (length >> shift);
+        base   += x;
+        length -= x;
+        if (init_base > base) propagate_carry();           // overflow = carry
+        if (length < AC__MinLength) renorm_enc_interval();
+      } while (--n);
+    if (M.bits_until_update == 0) M.update();         // periodic model update
+  }
+
+  if (terminated) encode(bit ^ 1U, M);               // different bit ends run
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+unsigned Arithmetic_Codec::decode_run(unsigned bit,
+                                      unsigned max_run,
+                                      Adaptive_Bit_Model & M)
+{
+#ifdef _DEBUG
+  if (mode != 2) AC_Error("decoder not initialized");
+#endif
+
+  unsigned run = 0, shift = M.length_shift;
+
+  while (run < max_run) {  // model is constant until the next periodic update
+    unsigned k = 0, n = M.bits_until_update, p = M.bit_0_prob;
+    if (n > max_run - run) n = max_run - run;
+    if (bit == 0)
+      for (; k < n; k++) {
+        unsigned x = p * (length >> shift);                  // product l x p0
+        if (value >= x) break;                            // bit 1: end of run
+        length = x;
+        if (length < AC__MinLength) renorm_dec_interval();
+      }
+    else
+      for (; k < n; k++) {
+        unsigned x = p * (length >> shift);                  // product l x p0
+        if (value < x) break;                             // bit 0: end of run
+        value  -= x;
+        length -= x;
+        if (length < AC__MinLength) renorm_dec_interval();
+      }
+    run += k;
+    M.bits_until_update -= k;
+    if (bit == 0) M.bit_0_count += k;
+    if (k < n) {                         // decode and count the different bit
+      decode(M);
+      break;
+    }
+    if (M.bits_until_update == 0) M.update();         // periodic model update
+  }
+
+  return run;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
 void Arithmetic_Codec::encode(unsigned data,
                               Static_Data_Model & M)
 {
@@ -285,12 +647,12 @@ void Arithmetic_Codec::encode(unsigned data,
   unsigned x, init_base = base;
                                                            // compute products
   if (data == M.last_symbol) {
-    x = M.distribution[data] * (length >> DM__LengthShift);
+    x = M.distribution[data] * (length >> M.length_shift);
     base   += x;                                            // update interval
     length -= x;                                          // no product needed
   }
   else {
-    x = M.distribution[data] * (length >>= DM__LengthShift);
+    x = M.distribution[data] * (length >>= M.length_shift);
     base   += x;                                            // update interval
     length  = M.distribution[data+1] * length - x;
   }
@@ -312,7 +674,7 @@ unsigned Arithmetic_Codec::decode(Static_Data_Model & M)
 
   if (M.decoder_table) {              // use table look-up for faster decoding
 
-    unsigned dv = value / (length >>= DM__LengthShift);
+    unsigned dv = value / (length >>= M.length_shift);
     unsigned t = dv >> M.table_shift;
 
     s = M.decoder_table[t];         // initial decision based on table look-up
@@ -330,7 +692,7 @@ unsigned Arithmetic_Codec::decode(Static_Data_Model & M)
   else {                                  // decode using only multiplications
 
     x = s = 0;
-    length >>= DM__LengthShift;
+    length >>= M.length_shift;
     unsigned m = (n = M.data_symbols) >> 1;
                                                 // decode via bisection search
     do {
@@ -367,12 +729,12 @@ void Arithmetic_Codec::encode(unsigned data,
   unsigned x, init_base = base;
                                                            // compute products
   if (data == M.last_symbol) {
-    x = M.distribution[data] * (length >> DM__LengthShift);
+    x = M.distribution[data] * (length >> M.length_shift);
     base   += x;                                            // update interval
     length -= x;                                          // no product needed
   }
   else {
-    x = M.distribution[data] * (length >>= DM__LengthShift);
+    x = M.distribution[data] * (length >>= M.length_shift);
     base   += x;                                            // update interval
     length  = M.distribution[data+1] * length - x;
   }
@@ -397,7 +759,7 @@ unsigned Arithmetic_Codec::decode(Adaptive_Data_Model & M)
 
   if (M.decoder_table) {              // use table look-up for faster decoding
 
-    unsigned dv = value / (length >>= DM__LengthShift);
+    unsigned dv = value / (length >>= M.length_shift);
     unsigned t = dv >> M.table_shift;
 
     s = M.decoder_table[t];         // initial decision based on table look-up
@@ -415,7 +777,7 @@ unsigned Arithmetic_Codec::decode(Adaptive_Data_Model & M)
   else {                                  // decode using only multiplications
 
     x = s = 0;
-    length >>= DM__LengthShift;
+    length >>= M.length_shift;
     unsigned m = (n = M.data_symbols) >> 1;
                                                 // decode via bisection search
     do {
@@ -442,6 +804,236 @@ unsigned Arithmetic_Codec::decode(Adaptive_Data_Model & M)
   return s;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void Arithmetic_Codec::encode(unsigned data,
+                              Adaptive_Sparse_Model & M)
+{
+#ifdef _DEBUG
+  if (mode != 1) AC_Error("encoder not initialized");
+  if (data >= M.data_symbols) AC_Error("invalid data symbol");
+#endif
+
+  unsigned x, init_base = base;             // index in model, or 0 for escape
+  unsigned k = M.symbol_index[data];
+  if (k >= M.coded_symbols) k = 0;
+                                                           // compute products
+  if (k == M.last_symbol) {
+    x = M.distribution[k] * (length >> DM__LengthShift);
+    base   += x;                                            // update interval
+    length -= x;                                          // no product needed
+  }
+  else {
+    x = M.distribution[k] * (length >>= DM__LengthShift);
+    base   += x;                                            // update interval
+    length  = M.distribution[k+1] * length - x;
+  }
+
+  if (init_base > base) propagate_carry();                 // overflow = carry
+
+  if (length < AC__MinLength) renorm_enc_interval();        // renormalization
+
+  ++M.symbol_count[k];
+  if (k == 0) {                   // escape: new symbol is sent as "raw" bits
+    put_bits(data, M.symbol_bits);
+    unsigned n = M.symbol_index[data];
+    if (n != 0)
+      ++M.symbol_count[n];                   // used, but not yet in estimates
+    else
+      if (M.used_symbols <= M.max_symbols) {
+        M.symbol_index[data] = (unsigned short) M.used_symbols;
+        M.index_symbol[M.used_symbols] = data;
+        M.symbol_count[M.used_symbols++] = 1;
+      }
+  }
+  if (--M.symbols_until_update == 0) M.update(true);  // periodic model update
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+unsigned Arithmetic_Codec::decode(Adaptive_Sparse_Model & M)
+{
+#ifdef _DEBUG
+  if (mode != 2) AC_Error("decoder not initialized");
+#endif
+
+  unsigned n, s, x, y = length;
+
+  if (M.table_size) {                 // use table look-up for faster decoding
+
+    unsigned dv = value / (length >>= DM__LengthShift);
+    unsigned t = dv >> M.table_shift;
+
+    s = M.decoder_table[t];         // initial decision based on table look-up
+    n = M.decoder_table[t+1] + 1;
+
+    while (n > s + 1) {                        // finish with bisection search
+      unsigned m = (s + n) >> 1;
+      if (M.distribution[m] > dv) n = m; else s = m;
+    }
+                                                           // compute products
+    x = M.distribution[s] * length;
+    if (s != M.last_symbol) y = M.distribution[s+1] * length;
+  }
+
+  else {                                  // decode using only multiplications
+
+    x = s = 0;
+    length >>= DM__LengthShift;
+    unsigned m = (n = M.coded_symbols) >> 1;
+                                                // decode via bisection search
+    do {
+      unsigned z = length * M.distribution[m];
+      if (z > value) {
+        n = m;
+        y = z;                                             // value is smaller
+      }
+      else {
+        s = m;
+        x = z;                                     // value is larger or equal
+      }
+    } while ((m = (s + n) >> 1) != s);
+  }
+
+  value -= x;                                               // update interval
+  length = y - x;
+
+  if (length < AC__MinLength) renorm_dec_interval();        // renormalization
+
+  ++M.symbol_count[s];
+  unsigned data;
+  if (s != 0)
+    data = M.index_symbol[s];
+  else {                                    // escape: read "raw" data symbol
+    data = get_bits(M.symbol_bits);
+    if ((n = M.symbol_index[data]) != 0)
+      ++M.symbol_count[n];
+    else
+      if (M.used_symbols <= M.max_symbols) {
+        M.symbol_index[data] = (unsigned short) M.used_symbols;
+        M.index_symbol[M.used_symbols] = data;
+        M.symbol_count[M.used_symbols++] = 1;
+      }
+  }
+  if (--M.symbols_until_update == 0) M.update(false);  // periodic model update
+
+  return data;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void Arithmetic_Codec::encode(int data,
+                              Adaptive_Integer_Model & M,
+                              unsigned context)
+{
+#ifdef _DEBUG
+  if (mode != 1) AC_Error("encoder not initialized");
+  if (context >= M.contexts) AC_Error("invalid integer model context");
+#endif
+
+  unsigned a = unsigned(data);                      // magnitude and its class
+  if (M.signed_data && (data < 0)) a = 0U - a;
+  unsigned c = AC_Bit_Length(a);
+
+  encode(c, M.class_model[context]);                // Elias-gamma style class
+
+  if (c > 1) {                     // mantissa = bits below most significant 1
+    unsigned bits = c - 1, m = a - (1U << bits);
+    unsigned node = 1, mb = (bits < M.modeled_bits ? bits : M.modeled_bits);
+    Adaptive_Bit_Model * bm = M.mantissa_model + (c << M.modeled_bits);
+    while (mb--) {                          // adaptive coding of the top bits
+      unsigned bit = (m >> --bits) & 1U;
+      encode(bit, bm[node]);
+      node = (node << 1) | bit;
+    }
+    while (bits > IM__RawBits) {                 // remaining bits are "raw"
+      bits -= IM__RawBits;
+      put_bits((m >> bits) & ((1U << IM__RawBits) - 1), IM__RawBits);
+    }
+    if (bits) put_bits(m & ((1U << bits) - 1), bits);
+  }
+
+  if (M.signed_data && c) put_bit(data < 0);                    // sign is raw
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+int Arithmetic_Codec::decode(Adaptive_Integer_Model & M,
+                             unsigned context)
+{
+#ifdef _DEBUG
+  if (mode != 2) AC_Error("decoder not initialized");
+  if (context >= M.contexts) AC_Error("invalid integer model context");
+#endif
+
+  unsigned c = decode(M.class_model[context]), a = c;       // magnitude class
+
+  if (c > 1) {
+    unsigned bits = c - 1, m = 1;            // leading 1 followed by mantissa
+    unsigned node = 1, mb = (bits < M.modeled_bits ? bits : M.modeled_bits);
+    Adaptive_Bit_Model * bm = M.mantissa_model + (c << M.modeled_bits);
+    for (bits -= mb; mb; mb--) {
+      unsigned bit = decode(bm[node]);
+      node = (node << 1) | bit;
+      m = (m << 1) | bit;
+    }
+    for (; bits > IM__RawBits; bits -= IM__RawBits)
+      m = (m << IM__RawBits) | get_bits(IM__RawBits);
+    if (bits) m = (m << bits) | get_bits(bits);
+    a = m;
+  }
+
+  if (M.signed_data && a && get_bit()) return int(0U - a);  // sign is raw bit
+  return int(a);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void Arithmetic_Codec::encode_interval(unsigned low_count,
+                                       unsigned count,
+                                       unsigned total_count)
+{
+#ifdef _DEBUG
+  if (mode != 1) AC_Error("encoder not initialized");
+  if ((count == 0) || (low_count + count > total_count) ||
+      (total_count > IC__MaxTotal)) AC_Error("invalid coding interval");
+#endif
+
+  unsigned init_base = base;
+  length /= total_count;                    // interval of one count, and then
+  base   += length * low_count;                         // of the symbol's own
+  length *= count;
+
+  if (init_base > base) propagate_carry();                 // overflow = carry
+
+  if (length < AC__MinLength) renorm_enc_interval();        // renormalization
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+unsigned Arithmetic_Codec::decode_count(unsigned total_count)
+{
+#ifdef _DEBUG
+  if (mode != 2) AC_Error("decoder not initialized");
+  if ((total_count == 0) || (total_count > IC__MaxTotal))
+    AC_Error("invalid coding interval");
+#endif
+
+  unsigned c = value / (length /= total_count);      // length of one count is
+  return (c < total_count ? c : total_count - 1);   // kept by decode_interval
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void Arithmetic_Codec::decode_interval(unsigned low_count,
+                                       unsigned count)
+{
+  value -= length * low_count;                              // update interval
+  length *= count;
+
+  if (length < AC__MinLength) renorm_dec_interval();        // renormalization
+}
+
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 // - - Other Arithmetic_Codec implementations  - - - - - - - - - - - - - - - -
@@ -598,13 +1190,72 @@ void Arithmetic_Codec::stop_decoder(void)
   mode = 0;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void Arithmetic_Codec::checkpoint(Codec_Checkpoint & C)
+{
+  if ((mode != 1) && (mode != 2)) AC_Error("codec not initialized");
+
+  C.mode   = mode;
+  C.base   = base;
+  C.value  = value;
+  C.length = length;
+  C.code_bytes = unsigned(ac_pointer - code_buffer);
+                // a later carry can add at most 1 to the bytes already coded:
+                 // it changes only the last bytes equal to 0xFF, and one more
+  unsigned char * p = ac_pointer;
+  if (mode == 1) while ((p > code_buffer) && (p[-1] == 0xFFU)) --p;
+  C.carry_bytes = unsigned(ac_pointer - p);
+  C.carry_byte  = (p > code_buffer ? p[-1] : 0);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void Arithmetic_Codec::rollback(const Codec_Checkpoint & C)
+{
+  if ((C.mode != mode) || (mode == 0)) AC_Error("invalid codec checkpoint");
+
+  base   = C.base;
+  value  = C.value;
+  length = C.length;
+  ac_pointer = code_buffer + C.code_bytes;
+                                    // undo carries into bytes coded before it
+  if (mode == 1) {
+    unsigned char * p = ac_pointer - C.carry_bytes;
+    if (p > code_buffer) p[-1] = C.carry_byte;
+    memset(p, 0xFF, C.carry_bytes);
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+unsigned Arithmetic_Codec::code_bits(void)
+{
+#ifdef _DEBUG
+  if (mode != 1) AC_Error("encoder not initialized");
+#endif
+                           // bytes written, plus bits of the pending interval
+  return 8 * unsigned(ac_pointer - code_buffer) + 32 - AC_Bit_Length(length);
+}
+
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 // - Static bit model implementation - - - - - - - - - - - - - - - - - - - - -
 
 Static_Bit_Model::Static_Bit_Model(void)
 {
-  bit_0_prob = 1U << (BM__LengthShift - 1);                        // p0 = 0.5
+  length_shift = BM__LengthShift;
+  bit_0_prob = 1U << (length_shift - 1);                           // p0 = 0.5
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void Static_Bit_Model::set_precision(unsigned bits)
+{
+  if ((bits < BM__MinShift) || (bits > BM__MaxShift))
+    AC_Error("invalid model precision");
+  length_shift = bits;
+  bit_0_prob = 1U << (length_shift - 1);                           // p0 = 0.5
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -612,7 +1263,18 @@ Static_Bit_Model::Static_Bit_Model(void)
 void Static_Bit_Model::set_probability_0(double p0)
 {
   if ((p0 < 0.0001)||(p0 > 0.9999)) AC_Error("invalid bit probability");
-  bit_0_prob = unsigned(p0 * (1 << BM__LengthShift));
+  unsigned max_prob = (1U << length_shift) - 1;
+  bit_0_prob = unsigned(p0 * (1 << length_shift));
+  if (bit_0_prob == 0) bit_0_prob = 1;      // both bits need a valid interval
+  if (bit_0_prob > max_prob) bit_0_prob = max_prob;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+unsigned Static_Bit_Model::cost(unsigned bit)
+{
+  unsigned p = (bit ? (1U << length_shift) - bit_0_prob : bit_0_prob);
+  return (length_shift << CE__FractionBits) - CE_Log2(p);
 }
 
 
@@ -621,6 +1283,17 @@ void Static_Bit_Model::set_probability_0(double p0)
 
 Adaptive_Bit_Model::Adaptive_Bit_Model(void)
 {
+  length_shift = BM__LengthShift;
+  reset();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void Adaptive_Bit_Model::set_precision(unsigned bits)
+{
+  if ((bits < BM__MinShift) || (bits > BM__MaxShift))
+    AC_Error("invalid model precision");
+  length_shift = bits;
   reset();
 }
 
@@ -631,7 +1304,7 @@ void Adaptive_Bit_Model::reset(void)
                                        // initialization to equiprobable model
   bit_0_count = 1;
   bit_count   = 2;
-  bit_0_prob  = 1U << (BM__LengthShift - 1);
+  bit_0_prob  = 1U << (length_shift - 1);
   update_cycle = bits_until_update = 4;         // start with frequent updates
 }
 
@@ -641,14 +1314,14 @@ void Adaptive_Bit_Model::update(void)
 {
                                    // halve counts when a threshold is reached
 
-  if ((bit_count += update_cycle) > BM__MaxCount) {
+  if ((bit_count += update_cycle) > (1U << length_shift)) {
     bit_count = (bit_count + 1) >> 1;
     bit_0_count = (bit_0_count + 1) >> 1;
     if (bit_0_count == bit_count) ++bit_count;
   }
                                            // compute scaled bit 0 probability
   unsigned scale = 0x80000000U / bit_count;
-  bit_0_prob = (bit_0_count * scale) >> (31 - BM__LengthShift);
+  bit_0_prob = (bit_0_count * scale) >> (31 - length_shift);
 
                                              // set frequency of model updates
   update_cycle = (5 * update_cycle) >> 2;
@@ -656,6 +1329,24 @@ void Adaptive_Bit_Model::update(void)
   bits_until_update = update_cycle;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+unsigned Adaptive_Bit_Model::cost(unsigned bit)
+{
+  unsigned p = (bit ? (1U << length_shift) - bit_0_prob : bit_0_prob);
+  return (length_shift << CE__FractionBits) - CE_Log2(p);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+unsigned Adaptive_Bit_Model::estimate(unsigned bit)
+{
+  unsigned c = cost(bit);
+  if (bit == 0) ++bit_0_count;            // same update as encoder, no coding
+  if (--bits_until_update == 0) update();
+  return c;
+}
+
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 // - - Static data model implementation  - - - - - - - - - - - - - - - - - - -
@@ -664,6 +1355,7 @@ Static_Data_Model::Static_Data_Model(void)
 {
   data_symbols = 0;
   distribution = 0;
+  length_shift = DM__LengthShift;
 }
 
 Static_Data_Model::~Static_Data_Model(void)
@@ -688,7 +1380,6 @@ void Static_Data_Model::set_distribution(unsigned number_of_symbols,
       unsigned table_bits = 3;
       while (data_symbols > (1U << (table_bits + 2))) ++table_bits;
       table_size  = 1 << table_bits;
-      table_shift = DM__LengthShift - table_bits;
       distribution = new unsigned[data_symbols+table_size+2];
       decoder_table = distribution + data_symbols;
     }
@@ -699,14 +1390,19 @@ void Static_Data_Model::set_distribution(unsigned number_of_symbols,
     }
     if (distribution == 0) AC_Error("cannot assign model memory");
   }
+                        // table index: top bits of the interval, as precision
+  if (table_size != 0)
+    table_shift = length_shift + 1 - AC_Bit_Length(table_size);
                              // compute cumulative distribution, decoder table
   unsigned s = 0;
   double sum = 0.0, p = 1.0 / double(data_symbols);
+  double min_p = 1.0 / double(1U << length_shift);  // so no interval is empty
 
   for (unsigned k = 0; k < data_symbols; k++) {
     if (probability) p = probability[k];
-    if ((p < 0.0001) || (p > 0.9999)) AC_Error("invalid symbol probability");
-    distribution[k] = unsigned(sum * (1 << DM__LengthShift));
+    if ((p < 0.0001) || (p < min_p) || (p > 0.9999))
+      AC_Error("invalid symbol probability");
+    distribution[k] = unsigned(sum * (1 << length_shift));
     sum += p;
     if (table_size == 0) continue;
     unsigned w = distribution[k] >> table_shift;
@@ -721,6 +1417,27 @@ void Static_Data_Model::set_distribution(unsigned number_of_symbols,
   if ((sum < 0.9999) || (sum > 1.0001)) AC_Error("invalid probabilities");
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void Static_Data_Model::set_precision(unsigned bits)
+{
+  if ((bits < DM__MinShift) || (bits > DM__MaxShift))
+    AC_Error("invalid model precision");
+  length_shift = bits;
+  if (data_symbols != 0) set_distribution(data_symbols);        // now uniform
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+unsigned Static_Data_Model::cost(unsigned data)
+{
+#ifdef _DEBUG
+  if (data >= data_symbols) AC_Error("invalid data symbol");
+#endif
+
+  return CE_Data_Cost(distribution, data, last_symbol, length_shift);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 // - - Adaptive data model implementation  - - - - - - - - - - - - - - - - - -
 
@@ -728,12 +1445,14 @@ Adaptive_Data_Model::Adaptive_Data_Model(void)
 {
   data_symbols = 0;
   distribution = 0;
+  length_shift = DM__LengthShift;
 }
 
 Adaptive_Data_Model::Adaptive_Data_Model(unsigned number_of_symbols)
 {
   data_symbols = 0;
   distribution = 0;
+  length_shift = DM__LengthShift;
   set_alphabet(number_of_symbols);
 }
 
@@ -746,7 +1465,8 @@ Adaptive_Data_Model::~Adaptive_Data_Model(void)
 
 void Adaptive_Data_Model::set_alphabet(unsigned number_of_symbols)
 {
-  if ((number_of_symbols < 2) || (number_of_symbols > (1 << 11)))
+  if ((number_of_symbols < 2) || (number_of_symbols > (1 << 11)) ||
+      (number_of_symbols > (1U << (length_shift - 4))))
     AC_Error("invalid number of data symbols");
 
   if (data_symbols != number_of_symbols) {     // assign memory for data model
@@ -758,7 +1478,6 @@ void Adaptive_Data_Model::set_alphabet(unsigned number_of_symbols)
       unsigned table_bits = 3;
       while (data_symbols > (1U << (table_bits + 2))) ++table_bits;
       table_size  = 1 << table_bits;
-      table_shift = DM__LengthShift - table_bits;
       distribution = new unsigned[2*data_symbols+table_size+2];
       decoder_table = distribution + 2 * data_symbols;
     }
@@ -770,17 +1489,30 @@ void Adaptive_Data_Model::set_alphabet(unsigned number_of_symbols)
     symbol_count = distribution + data_symbols;
     if (distribution == 0) AC_Error("cannot assign model memory");
   }
+                        // table index: top bits of the interval, as precision
+  if (table_size != 0)
+    table_shift = length_shift + 1 - AC_Bit_Length(table_size);
 
   reset();                                                 // initialize model
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+void Adaptive_Data_Model::set_precision(unsigned bits)
+{
+  if ((bits < DM__MinShift) || (bits > DM__MaxShift))
+    AC_Error("invalid model precision");
+  length_shift = bits;
+  if (data_symbols != 0) set_alphabet(data_symbols);       // new table, reset
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
 void Adaptive_Data_Model::update(bool from_encoder)
 {
                                    // halve counts when a threshold is reached
 
-  if ((total_count += update_cycle) > DM__MaxCount) {
+  if ((total_count += update_cycle) > (1U << length_shift)) {
     total_count = 0;
     for (unsigned n = 0; n < data_symbols; n++)
       total_count += (symbol_count[n] = (symbol_count[n] + 1) >> 1);
@@ -791,12 +1523,12 @@ void Adaptive_Data_Model::update(bool from_encoder)
 
   if (from_encoder || (table_size == 0))
     for (k = 0; k < data_symbols; k++) {
-      distribution[k] = (scale * sum) >> (31 - DM__LengthShift);
+      distribution[k] = (scale * sum) >> (31 - length_shift);
       sum += symbol_count[k];
     }
   else {
     for (k = 0; k < data_symbols; k++) {
-      distribution[k] = (scale * sum) >> (31 - DM__LengthShift);
+      distribution[k] = (scale * sum) >> (31 - length_shift);
       sum += symbol_count[k];
       unsigned w = distribution[k] >> table_shift;
       while (s < w) decoder_table[++s] = k - 1;
@@ -825,4 +1557,282 @@ void Adaptive_Data_Model::reset(void)
   symbols_until_update = update_cycle = (data_symbols + 6) >> 1;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void Adaptive_Data_Model::copy(const Adaptive_Data_Model & M)
+{
+  if (M.data_symbols == 0) AC_Error("invalid data model copy");
+  if ((data_symbols != M.data_symbols) || (length_shift != M.length_shift)) {
+    length_shift = M.length_shift;
+    set_alphabet(M.data_symbols);
+  }
+
+  total_count = M.total_count;                        // counts, distribution,
+  update_cycle = M.update_cycle;                          // and decoder table
+  symbols_until_update = M.symbols_until_update;
+  unsigned words = 2 * data_symbols + (table_size ? table_size + 2 : 0);
+  memcpy(distribution, M.distribution, words * sizeof(unsigned));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+unsigned Adaptive_Data_Model::cost(unsigned data)
+{
+#ifdef _DEBUG
+  if (data >= data_symbols) AC_Error("invalid data symbol");
+#endif
+
+  return CE_Data_Cost(distribution, data, last_symbol, length_shift);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+unsigned Adaptive_Data_Model::estimate(unsigned data)
+{
+#ifdef _DEBUG
+  if (data >= data_symbols) AC_Error("invalid data symbol");
+#endif
+
+  unsigned c = CE_Data_Cost(distribution, data, last_symbol, length_shift);
+  ++symbol_count[data];                   // same update as encoder, no coding
+  if (--symbols_until_update == 0) update(true);
+  return c;
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// - - Adaptive sparse model implementation  - - - - - - - - - - - - - - - - -
+
+Adaptive_Sparse_Model::Adaptive_Sparse_Model(void)
+{
+  data_symbols = 0;
+  distribution = 0;
+  symbol_index = 0;
+}
+
+Adaptive_Sparse_Model::Adaptive_Sparse_Model(unsigned number_of_symbols)
+{
+  data_symbols = 0;
+  distribution = 0;
+  symbol_index = 0;
+  set_alphabet(number_of_symbols);
+}
+
+Adaptive_Sparse_Model::~Adaptive_Sparse_Model(void)
+{
+  delete [] distribution;
+  delete [] symbol_index;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void Adaptive_Sparse_Model::set_alphabet(unsigned number_of_symbols)
+{
+  if ((number_of_symbols < 2) || (number_of_symbols > SM__MaxSymbols))
+    AC_Error("invalid number of data symbols");
+
+  if (data_symbols != number_of_symbols) {     // assign memory for data model
+    data_symbols = number_of_symbols;
+    max_symbols = (data_symbols < SM__MaxUsed ? data_symbols : SM__MaxUsed);
+    symbol_bits = AC_Bit_Length(data_symbols - 1);
+    delete [] distribution;
+    delete [] symbol_index;
+                    // memory for distribution, counts, symbols, decoder table
+    unsigned dim = max_symbols + 1, max_table = 8;
+    while (dim > (max_table << 2)) max_table <<= 1;
+    distribution  = new unsigned[3*dim+max_table+2];
+    symbol_index  = new unsigned short[data_symbols];
+    if ((distribution == 0) || (symbol_index == 0))
+      AC_Error("cannot assign model memory");
+    symbol_count  = distribution + dim;
+    index_symbol  = distribution + 2 * dim;
+    decoder_table = distribution + 3 * dim;
+    for (unsigned n = 0; n < data_symbols; n++) symbol_index[n] = 0;
+    used_symbols = 1;
+  }
+
+  reset();                                                 // initialize model
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void Adaptive_Sparse_Model::update(bool from_encoder)
+{
+                   // escape is not needed once all symbols have own estimates
+  if (used_symbols > data_symbols) symbol_count[0] = 0;
+
+  unsigned k;                   // only symbols in use are counted and updated
+  for (total_count = k = 0; k < used_symbols; k++)
+    total_count += symbol_count[k];
+                                   // halve counts when a threshold is reached
+  if (total_count > DM__MaxCount)
+    for (total_count = k = 0; k < used_symbols; k++)
+      total_count += (symbol_count[k] = (symbol_count[k] + 1) >> 1);
+
+  coded_symbols = used_symbols;              // new symbols now have estimates
+  last_symbol = coded_symbols - 1;
+                                     // define size of table for fast decoding
+  if (coded_symbols > 16) {
+    unsigned table_bits = 3;
+    while (coded_symbols > (1U << (table_bits + 2))) ++table_bits;
+    table_size  = 1 << table_bits;
+    table_shift = DM__LengthShift - table_bits;
+  }
+  else
+    table_size = table_shift = 0;
+                             // compute cumulative distribution, decoder table
+  unsigned sum = 0, s = 0;
+  unsigned scale = 0x80000000U / total_count;
+
+  if (from_encoder || (table_size == 0))
+    for (k = 0; k < coded_symbols; k++) {
+      distribution[k] = (scale * sum) >> (31 - DM__LengthShift);
+      sum += symbol_count[k];
+    }
+  else {
+    for (k = 0; k < coded_symbols; k++) {
+      distribution[k] = (scale * sum) >> (31 - DM__LengthShift);
+      sum += symbol_count[k];
+      unsigned w = distribution[k] >> table_shift;
+      while (s < w) decoder_table[++s] = k - 1;
+    }
+    decoder_table[0] = 0;
+    while (s <= table_size) decoder_table[++s] = coded_symbols - 1;
+  }
+                                             // set frequency of model updates
+  update_cycle = (5 * update_cycle) >> 2;
+  unsigned max_cycle = (coded_symbols + 6) << 3;
+  if (update_cycle > max_cycle) update_cycle = max_cycle;
+  symbols_until_update = update_cycle;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void Adaptive_Sparse_Model::reset(void)
+{
+  if (data_symbols == 0) return;
+
+                    // forget all symbols: only escape has nonzero probability
+  for (unsigned n = 1; n < used_symbols; n++)
+    symbol_index[index_symbol[n]] = 0;
+  used_symbols = symbol_count[0] = 1;
+  update_cycle = 4;
+  update(false);
+  symbols_until_update = update_cycle = 4;          // start with fast updates
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void Adaptive_Sparse_Model::copy(const Adaptive_Sparse_Model & M)
+{
+  if (M.data_symbols == 0) AC_Error("invalid sparse model copy");
+  if (data_symbols != M.data_symbols) set_alphabet(M.data_symbols);
+
+  unsigned n;                      // only indices of used symbols are changed
+  for (n = 1; n < used_symbols; n++) symbol_index[index_symbol[n]] = 0;
+  for (n = 1; n < M.used_symbols; n++)
+    symbol_index[M.index_symbol[n]] = (unsigned short) n;
+
+  total_count = M.total_count;
+  update_cycle = M.update_cycle;
+  symbols_until_update = M.symbols_until_update;
+  used_symbols = M.used_symbols;
+  coded_symbols = M.coded_symbols;
+  last_symbol = M.last_symbol;
+  table_size = M.table_size;
+  table_shift = M.table_shift;
+                    // memory for distribution, counts, symbols, decoder table
+  unsigned dim = max_symbols + 1, max_table = 8;
+  while (dim > (max_table << 2)) max_table <<= 1;
+  memcpy(distribution, M.distribution, (3*dim+max_table+2)*sizeof(unsigned));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// - - Adaptive integer model implementation - - - - - - - - - - - - - - - - -
+
+Adaptive_Integer_Model::Adaptive_Integer_Model(void)
+{
+  contexts = modeled_bits = 0;
+  signed_data = true;
+  class_model = 0;
+  mantissa_model = 0;
+}
+
+Adaptive_Integer_Model::Adaptive_Integer_Model(unsigned number_of_contexts,
+                                               bool signed_data,
+                                               unsigned modeled_bits)
+{
+  contexts = 0;
+  class_model = 0;
+  mantissa_model = 0;
+  set_contexts(number_of_contexts, signed_data, modeled_bits);
+}
+
+Adaptive_Integer_Model::~Adaptive_Integer_Model(void)
+{
+  delete [] class_model;
+  delete [] mantissa_model;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void Adaptive_Integer_Model::set_contexts(unsigned number_of_contexts,
+                                          bool signed_integers,
+                                          unsigned mantissa_bits)
+{
+  if ((number_of_contexts < 1) || (number_of_contexts > (1 << 16)))
+    AC_Error("invalid number of integer model contexts");
+  if (mantissa_bits > IM__MaxBits)
+    AC_Error("invalid number of modeled mantissa bits");
+
+  signed_data = signed_integers;
+                                              // assign memory for data models
+  if (contexts != number_of_contexts) {
+    contexts = number_of_contexts;
+    delete [] class_model;
+    class_model = new Adaptive_Data_Model[contexts];
+    if (class_model == 0) AC_Error("cannot assign model memory");
+    for (unsigned n = 0; n < contexts; n++)
+      class_model[n].set_alphabet(IM__Classes);
+  }
+  else
+    for (unsigned n = 0; n < contexts; n++) class_model[n].reset();
+
+  if ((mantissa_model == 0) || (modeled_bits != mantissa_bits)) {
+    modeled_bits = mantissa_bits;      // one binary tree for each class: bits
+    delete [] mantissa_model;          // are coded using the class and prefix
+    mantissa_model = new Adaptive_Bit_Model[IM__Classes<<modeled_bits];
+    if (mantissa_model == 0) AC_Error("cannot assign model memory");
+  }
+  else
+    for (unsigned n = 0; n < (IM__Classes << modeled_bits); n++)
+      mantissa_model[n].reset();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void Adaptive_Integer_Model::reset(void)
+{
+  if (contexts == 0) return;
+                                    // restore all models to uniform estimates
+  for (unsigned n = 0; n < contexts; n++) class_model[n].reset();
+  for (unsigned k = 0; k < (IM__Classes << modeled_bits); k++)
+    mantissa_model[k].reset();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void Adaptive_Integer_Model::copy(const Adaptive_Integer_Model & M)
+{
+  if (M.contexts == 0) AC_Error("invalid integer model copy");
+  if ((contexts != M.contexts) || (modeled_bits != M.modeled_bits))
+    set_contexts(M.contexts, M.signed_data, M.modeled_bits);
+
+  signed_data = M.signed_data;
+  for (unsigned n = 0; n < contexts; n++)
+    class_model[n].copy(M.class_model[n]);
+  for (unsigned k = 0; k < (IM__Classes << modeled_bits); k++)
+    mantissa_model[k] = M.mantissa_model[k];
+}
+
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
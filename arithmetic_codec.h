@@ -59,10 +59,15 @@ public:
 
   Static_Bit_Model(void);
 
+  unsigned precision(void) { return length_shift; }
+
+  void set_precision(unsigned bits);    // 8 to 16 (default 13), sets p0 = 0.5
   void set_probability_0(double);             // set probability of symbol '0'
 
+  unsigned cost(unsigned bit);      // 256 x number of bits used to code 'bit'
+
 private:  //  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .
-  unsigned bit_0_prob;
+  unsigned bit_0_prob, length_shift;
   friend class Arithmetic_Codec;
 };
 
@@ -76,14 +81,21 @@ public:
  ~Static_Data_Model(void);
 
   unsigned model_symbols(void) { return data_symbols; }
+  unsigned precision(void) { return length_shift; }
 
-  void set_distribution(unsigned number_of_symbols,
-                        const double probability[] = 0);    // 0 means uniform
+  void set_precision(unsigned bits);    // 10 to 16 (default 15), sets uniform
+  void set_distribution(unsigned number_of_symbols,   // probabilities must be
+                        const double probability[] = 0);    // >= 2^-precision
+
+  unsigned cost(unsigned data);    // 256 x number of bits used to code 'data'
 
 private:  //  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .
   unsigned * distribution, * decoder_table;
-  unsigned data_symbols, last_symbol, table_size, table_shift;
+  unsigned data_symbols, last_symbol, table_size, table_shift, length_shift;
   friend class Arithmetic_Codec;
+  friend class RANS_Codec;
+  friend class TANS_Codec;
+  friend class Huffman_Codec;
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -94,12 +106,19 @@ public:
 
   Adaptive_Bit_Model(void);         
 
+  unsigned precision(void) { return length_shift; }
+
+  void set_precision(unsigned bits);        // 8 to 16 (default 13), and reset
   void reset(void);                             // reset to equiprobable model
+  void copy(const Adaptive_Bit_Model & M) { *this = M; }     // same estimates
+
+  unsigned cost(unsigned bit);      // 256 x number of bits used to code 'bit'
+  unsigned estimate(unsigned bit);    // cost, and same model update as encode
 
 private:  //  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .
   void     update(void);
   unsigned update_cycle, bits_until_update;
-  unsigned bit_0_prob, bit_0_count, bit_count;
+  unsigned bit_0_prob, bit_0_count, bit_count, length_shift;
   friend class Arithmetic_Codec;
 };
 
@@ -114,15 +133,92 @@ public:
  ~Adaptive_Data_Model(void);
 
   unsigned model_symbols(void) { return data_symbols; }
+  unsigned precision(void) { return length_shift; }
 
+  void set_precision(unsigned bits);       // 10 to 16 (default 15), and reset
   void reset(void);                             // reset to equiprobable model
-  void set_alphabet(unsigned number_of_symbols);
+  void set_alphabet(unsigned number_of_symbols);        // 2^(precision-4) max
+  void copy(const Adaptive_Data_Model &);       // same alphabet and estimates
+
+  unsigned cost(unsigned data);    // 256 x number of bits used to code 'data'
+  unsigned estimate(unsigned data);   // cost, and same model update as encode
 
 private:  //  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .
   void     update(bool);
   unsigned * distribution, * symbol_count, * decoder_table;
   unsigned total_count, update_cycle, symbols_until_update;
-  unsigned data_symbols, last_symbol, table_size, table_shift;
+  unsigned data_symbols, last_symbol, table_size, table_shift, length_shift;
+  friend class Arithmetic_Codec;
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+class Adaptive_Sparse_Model   // adaptive model for data with few used symbols
+{
+public:
+
+  Adaptive_Sparse_Model(void);
+  Adaptive_Sparse_Model(unsigned number_of_symbols);
+ ~Adaptive_Sparse_Model(void);
+
+  unsigned model_symbols(void) { return data_symbols; }
+  unsigned active_symbols(void) { return used_symbols - 1; }
+
+  void reset(void);                          // reset to model with no symbols
+  void set_alphabet(unsigned number_of_symbols);
+  void copy(const Adaptive_Sparse_Model &);      // same symbols and estimates
+
+private:  //  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .
+  void     update(bool);
+  unsigned * distribution, * symbol_count, * decoder_table, * index_symbol;
+  unsigned short * symbol_index;           // 0 = not used (index 0 is escape)
+  unsigned total_count, update_cycle, symbols_until_update;
+  unsigned data_symbols, symbol_bits, max_symbols, used_symbols;
+  unsigned coded_symbols, last_symbol, table_size, table_shift;
+  friend class Arithmetic_Codec;
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+class Adaptive_Integer_Model                // adaptive model for integer data
+{
+public:
+
+  Adaptive_Integer_Model(void);
+  Adaptive_Integer_Model(unsigned number_of_contexts,
+                         bool signed_data = true,
+                         unsigned modeled_bits = 2);
+ ~Adaptive_Integer_Model(void);
+
+  unsigned model_contexts(void) { return contexts; }
+
+  void reset(void);                             // reset to equiprobable model
+  void set_contexts(unsigned number_of_contexts,
+                    bool signed_data = true,      // false = unsigned integers
+                    unsigned modeled_bits = 2);  // adaptive top mantissa bits
+  void copy(const Adaptive_Integer_Model &);    // same contexts and estimates
+
+private:  //  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .
+  Adaptive_Data_Model * class_model;       // magnitude class for each context
+  Adaptive_Bit_Model  * mantissa_model;   // tree of top mantissa bits / class
+  unsigned contexts, modeled_bits;
+  bool     signed_data;
+  friend class Arithmetic_Codec;
+};
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+class Codec_Checkpoint           // coder state (models are saved with copy())
+{
+public:
+
+  Codec_Checkpoint(void) { mode = 0; }
+
+private:  //  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .
+  unsigned base, value, length, mode;
+  unsigned code_bytes, carry_bytes;        // bytes a carry could still change
+  unsigned char carry_byte;
   friend class Arithmetic_Codec;
 };
 
@@ -158,9 +254,19 @@ public:
   void     put_bit(unsigned bit);
   unsigned get_bit(void);
 
-  void     put_bits(unsigned data, unsigned number_of_bits);
+  void     put_bits(unsigned data, unsigned number_of_bits);       // up to 20
   unsigned get_bits(unsigned number_of_bits);
 
+  void     put_bits32(unsigned data);                    // 32 and 64 raw bits
+  unsigned get_bits32(void);
+  void     put_bits64(unsigned long long data);
+  unsigned long long get_bits64(void);
+
+  void     put_bytes(const unsigned char * data,     // raw bytes: long arrays
+                     unsigned number_of_bytes);        // are copied unchanged
+  void     get_bytes(unsigned char * data,
+                     unsigned number_of_bytes);
+
   void     encode(unsigned bit,
                   Static_Bit_Model &);
   unsigned decode(Static_Bit_Model &);
@@ -173,10 +279,39 @@ public:
                   Adaptive_Bit_Model &);
   unsigned decode(Adaptive_Bit_Model &);
 
+  void     encode_run(unsigned bit,        // same as coding 'run_length' bits
+                      unsigned run_length,      // equal to 'bit', followed by
+                      unsigned max_run,       // a different bit if run_length
+                      Adaptive_Bit_Model &);               // is below max_run
+  unsigned decode_run(unsigned bit,
+                      unsigned max_run,       // returns run length: ends with
+                      Adaptive_Bit_Model &);     // a different bit or max_run
+
   void     encode(unsigned data,
                   Adaptive_Data_Model &);
   unsigned decode(Adaptive_Data_Model &);
 
+  void     encode(unsigned data,
+                  Adaptive_Sparse_Model &);
+  unsigned decode(Adaptive_Sparse_Model &);
+
+  void     encode(int data,                       // unsigned models code data
+                  Adaptive_Integer_Model &,        // as 32-bit unsigned value
+                  unsigned context = 0);
+  int      decode(Adaptive_Integer_Model &,
+                  unsigned context = 0);
+
+  void     encode_interval(unsigned low_count,      // symbol's interval given
+                           unsigned count,              // by counts, total up
+                           unsigned total_count);          // to 2^16: used by
+  unsigned decode_count(unsigned total_count);      // models kept outside the
+  void     decode_interval(unsigned low_count,       // codec; decode_count is
+                           unsigned count);     // followed by decode_interval
+
+  void     checkpoint(Codec_Checkpoint &);     // save state, to try different
+  void     rollback(const Codec_Checkpoint &);       // encodings and keep one
+  unsigned code_bits(void);              // bits used by encoder, rounded down
+
 private:  //  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .
   void propagate_carry(void);
   void renorm_enc_interval(void);
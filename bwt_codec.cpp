@@ -0,0 +1,436 @@
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+//                       ****************************                        -
+//                        ARITHMETIC CODING EXAMPLES                         -
+//                       ****************************                        -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+// Block-sorting (BWT) coding of data blocks with arithmetic coding          -
+// -> SA-IS suffix sorting, move-to-front ranks, and parallel inverse        -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+// Version 1.00  -  October 19, 2026                                         -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+//                                  WARNING                                  -
+//                                 =========                                 -
+//                                                                           -
+// The only purpose of this program is to demonstrate the basic principles   -
+// of arithmetic coding. It is provided as is, without any express or        -
+// implied warranty, without even the warranty of fitness for any particular -
+// purpose, or that the implementations are correct.                         -
+//                                                                           -
+// Permission to copy and redistribute this code is hereby granted, provided -
+// that this warning and copyright notices are not removed or altered.       -
+//                                                                           -
+// Copyright (c) 2026 by the FastAC contributors                             -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+
+// - - Inclusion - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bwt_codec.h"
+
+
+// - - Constants - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+const unsigned BWT__Walks     = 8;      // inverse BWT: interleaved walks over
+const unsigned BWT__WalkBytes = 65536;         // blocks of at least this size
+const unsigned BWT__MaxBytes  = 1U << 24;  // rows in 24 bits of inverse table
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// - - Static functions  - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+static void BWT_Error(const char * msg)
+{
+  fprintf(stderr, "\n\n -> BWT coding error: ");
+  fputs(msg, stderr);
+  fputs("\n Execution terminated!\n", stderr);
+  exit(1);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+static unsigned BWT_Segment(unsigned bytes,
+                            unsigned walks)
+{
+  return (bytes + walks - 1) / walks;
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// - - Suffix sorting: SA-IS algorithm of Nong, Zhang & Chan - - - - - - - - -
+
+static inline int SA_Symbol(const void * s,
+                            int cs,
+                            int i)
+{                           // 16-bit block text, or 32-bit names in recursion
+  if (cs == 2) return int(((const unsigned short *) s)[i]);
+  return ((const int *) s)[i];
+}
+
+static inline bool SA_S_Type(const unsigned char * t,
+                             int i)
+{                              // suffix types in bits: S (smaller) = 1, L = 0
+  return ((t[i>>3] >> (i & 7)) & 1) != 0;
+}
+
+static inline void SA_Set_Type(unsigned char * t,
+                               int i,
+                               bool s_type)
+{
+  if (s_type)
+    t[i>>3] |= (unsigned char)(1U << (i & 7));
+  else
+    t[i>>3] &= (unsigned char) ~(1U << (i & 7));
+}
+
+static inline bool SA_LMS_Type(const unsigned char * t,
+                               int i)
+{                                            // leftmost S in a run of S types
+  return (i > 0) && SA_S_Type(t, i) && !SA_S_Type(t, i - 1);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+static void SA_Buckets(const void * s,
+                       int * bucket,
+                       int n,
+                       int K,
+                       int cs,
+                       bool end)
+{                                      // start or end of each symbol's bucket
+  int sum = 0;
+  for (int c = 0; c <= K; c++) bucket[c] = 0;
+  for (int i = 0; i < n; i++) bucket[SA_Symbol(s, cs, i)]++;
+  for (int c = 0; c <= K; c++) {
+    sum += bucket[c];
+    bucket[c] = (end ? sum : sum - bucket[c]);
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+static void SA_Induce(const unsigned char * t,
+                      int * SA,
+                      const void * s,
+                      int * bucket,
+                      int n,
+                      int K,
+                      int cs)
+{                      // L-type suffixes from left to right, then S-type ones
+  SA_Buckets(s, bucket, n, K, cs, false);
+  for (int i = 0; i < n; i++) {
+    int j = SA[i] - 1;
+    if ((j >= 0) && !SA_S_Type(t, j)) SA[bucket[SA_Symbol(s, cs, j)]++] = j;
+  }
+  SA_Buckets(s, bucket, n, K, cs, true);
+  for (int i = n - 1; i >= 0; i--) {
+    int j = SA[i] - 1;
+    if ((j >= 0) && SA_S_Type(t, j)) SA[--bucket[SA_Symbol(s, cs, j)]] = j;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+static void SA_Sort(const void * s,
+                    int * SA,
+                    int n,
+                    int K,
+                    int cs)
+{            // suffix array of s[0..n-1], symbols 0 to K, with s[n-1] = 0 the
+  int i, j;                                 // only 0 (terminator), and n >= 2
+  unsigned char * t = new unsigned char[n/8+1];
+  SA_Set_Type(t, n - 2, false);
+  SA_Set_Type(t, n - 1, true);
+  for (i = n - 3; i >= 0; i--) {
+    int a = SA_Symbol(s, cs, i), b = SA_Symbol(s, cs, i + 1);
+    SA_Set_Type(t, i, (a < b) || ((a == b) && SA_S_Type(t, i + 1)));
+  }
+                                 // stage 1: sort LMS substrings, by induction
+  int * bucket = new int[K+1];
+  SA_Buckets(s, bucket, n, K, cs, true);
+  for (i = 0; i < n; i++) SA[i] = -1;
+  for (i = 1; i < n; i++)
+    if (SA_LMS_Type(t, i)) SA[--bucket[SA_Symbol(s, cs, i)]] = i;
+  SA_Induce(t, SA, s, bucket, n, K, cs);
+
+                   // move sorted LMS substrings to first n1 entries, and name
+  int n1 = 0;                                     // them by order (2 n1 <= n)
+  for (i = 0; i < n; i++)
+    if (SA_LMS_Type(t, SA[i])) SA[n1++] = SA[i];
+  for (i = n1; i < n; i++) SA[i] = -1;
+  int name = 0, previous = -1;
+  for (i = 0; i < n1; i++) {
+    int position = SA[i];
+    bool different = false;
+    for (int d = 0; d < n; d++)
+      if ((previous == -1) ||
+          (SA_Symbol(s, cs, position + d) !=
+           SA_Symbol(s, cs, previous + d)) ||
+          (SA_S_Type(t, position + d) != SA_S_Type(t, previous + d))) {
+        different = true;
+        break;
+      }
+      else
+        if ((d > 0) && (SA_LMS_Type(t, position + d) ||
+                        SA_LMS_Type(t, previous + d))) break;
+    if (different) {
+      name++;
+      previous = position;
+    }
+    SA[n1+position/2] = name - 1;
+  }
+  for (i = n - 1, j = n - 1; i >= n1; i--)
+    if (SA[i] >= 0) SA[j--] = SA[i];
+
+                     // stage 2: sort reduced string, recursively if names are
+  int * SA1 = SA, * s1 = SA + n - n1;                            // not unique
+  if (name < n1)
+    SA_Sort(s1, SA1, n1, name - 1, 4);
+  else
+    for (i = 0; i < n1; i++) SA1[s1[i]] = i;
+
+                      // stage 3: induce suffix array from sorted LMS suffixes
+  SA_Buckets(s, bucket, n, K, cs, true);
+  for (i = 1, j = 0; i < n; i++)
+    if (SA_LMS_Type(t, i)) s1[j++] = i;
+  for (i = 0; i < n1; i++) SA1[i] = s1[SA1[i]];
+  for (i = n1; i < n; i++) SA[i] = -1;
+  for (i = n1 - 1; i >= 0; i--) {
+    j = SA[i];
+    SA[i] = -1;
+    SA[--bucket[SA_Symbol(s, cs, j)]] = j;
+  }
+  SA_Induce(t, SA, s, bucket, n, K, cs);
+
+  delete [] bucket;
+  delete [] t;
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// - - BWT codec implementation  - - - - - - - - - - - - - - - - - - - - - - -
+
+BWT_Codec::BWT_Codec(void)
+{
+  run_length.set_contexts(2, false, 2);      // context: last class 1, or more
+  symbols = 0;
+  suffix = 0;
+  text = 0;
+  capacity = text_capacity = 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+BWT_Codec::~BWT_Codec(void)
+{
+  delete [] symbols;
+  delete [] suffix;
+  delete [] text;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void BWT_Codec::reset(void)
+{
+  run_length.reset();
+  for (unsigned c = 0; c < 9; c++)
+    for (unsigned n = 0; n < 128; n++) rank_bits[c][n].reset();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void BWT_Codec::reserve(unsigned block_bytes,
+                        bool encoder)
+{                        // buffers kept for next blocks, which have same size
+  if (capacity < block_bytes) {
+    delete [] symbols;
+    delete [] suffix;
+    symbols = new unsigned char[block_bytes];
+    suffix  = new int[block_bytes+1];
+    if ((symbols == 0) || (suffix == 0)) BWT_Error("cannot assign memory");
+    capacity = block_bytes;
+  }
+  if (encoder && (text_capacity < block_bytes)) {
+    delete [] text;
+    text = new unsigned short[block_bytes+1];
+    if (text == 0) BWT_Error("cannot assign memory");
+    text_capacity = block_bytes;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void BWT_Codec::encode(Arithmetic_Codec & codec,
+                       Context_Model & classes,
+                       const unsigned char block[],
+                       unsigned block_bytes)
+{
+  if (block_bytes >= BWT__MaxBytes) BWT_Error("block too large");
+  if (block_bytes == 0) return;                 // suffix sorting needs 1 byte
+  reserve(block_bytes, true);
+  unsigned walks = (block_bytes >= BWT__WalkBytes ? BWT__Walks : 1);
+  unsigned start_row[BWT__Walks];                 // first is terminator's row
+  forward(block, block_bytes, walks, start_row);
+  for (unsigned w = 0; w < walks; w++) codec.put_bits32(start_row[w]);
+
+  unsigned char order[256];               // move-to-front list of byte values
+  for (unsigned n = 0; n < 256; n++) order[n] = (unsigned char) n;
+
+  unsigned history = 0, run = 0;        // tokens: rank class 1 to 8, or 0 for
+  for (unsigned p = 0; p <= block_bytes; p++) {         // a run of zero ranks
+    unsigned rank = 0;
+    if (p < block_bytes) {
+      unsigned char c = symbols[p], previous = order[0];
+      while (previous != c) {
+        unsigned char next = order[++rank];
+        order[rank] = previous;
+        previous = next;
+      }
+      order[0] = c;
+      if (rank == 0) {
+        run++;
+        continue;
+      }
+    }
+    if (run) {                                    // run token, and its length
+      codec.encode(0, classes[history]);
+      codec.encode(int(run - 1), run_length, (history & 0xFFU) > 1);
+      history <<= 8;
+      run = 0;
+    }
+    if (rank) {                    // magnitude class of rank, then bits below
+      unsigned c = 1;                                // its most significant 1
+      while (rank >> c) c++;
+      codec.encode(c, classes[history]);
+      Adaptive_Bit_Model * bm = rank_bits[c];
+      for (unsigned b = c - 1, node = 1; b-- > 0; ) {
+        unsigned bit = (rank >> b) & 1U;
+        codec.encode(bit, bm[node]);
+        node = (node << 1) | bit;
+      }
+      history = (history << 8) | c;
+    }
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void BWT_Codec::decode(Arithmetic_Codec & codec,
+                       Context_Model & classes,
+                       unsigned char block[],
+                       unsigned block_bytes)
+{
+  if (block_bytes >= BWT__MaxBytes) BWT_Error("block too large");
+  if (block_bytes == 0) return;
+  reserve(block_bytes, false);
+  unsigned walks = (block_bytes >= BWT__WalkBytes ? BWT__Walks : 1);
+  unsigned start_row[BWT__Walks];
+  for (unsigned w = 0; w < walks; w++)
+    if ((start_row[w] = codec.get_bits32()) > block_bytes)
+      BWT_Error("invalid compressed data");
+
+  unsigned char order[256];
+  for (unsigned n = 0; n < 256; n++) order[n] = (unsigned char) n;
+
+  unsigned history = 0;
+  for (unsigned p = 0; p < block_bytes; ) {
+    unsigned rank = codec.decode(classes[history]), c = rank;
+    if (rank == 0) {                          // run of the first byte in list
+      unsigned run = unsigned(codec.decode(run_length,
+                                           (history & 0xFFU) > 1));
+      if (run >= block_bytes - p) BWT_Error("invalid compressed data");
+      memset(symbols + p, order[0], run + 1);
+      p += run + 1;
+      history <<= 8;
+    }
+    else {
+      if (c > 8) BWT_Error("invalid compressed data");
+      Adaptive_Bit_Model * bm = rank_bits[c];
+      for (rank = 1; rank < (1U << (c - 1)); )
+        rank = (rank << 1) | codec.decode(bm[rank]);
+      unsigned char byte = order[rank];
+      memmove(order + 1, order, rank);
+      order[0] = byte;
+      symbols[p++] = byte;
+      history = (history << 8) | c;
+    }
+  }
+
+  if (!inverse(block_bytes, walks, start_row, block))
+    BWT_Error("invalid compressed data");
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void BWT_Codec::forward(const unsigned char * data,
+                        unsigned bytes,
+                        unsigned walks,
+                        unsigned start_row[])
+{                 // last column of sorted rotations of block + terminator, in
+  for (unsigned p = 0; p < bytes; p++)                  // symbols without the
+    text[p] = (unsigned short)(data[p] + 1);                // terminator byte
+  text[bytes] = 0;
+  SA_Sort(text, suffix, int(bytes + 1), 256, 2);
+
+                          // rows of rotations that start each segment of data
+  unsigned segment = BWT_Segment(bytes, walks);       // (row 0 is terminator)
+  for (unsigned row = 0, k = 0; row <= bytes; row++) {
+    unsigned p = unsigned(suffix[row]);
+    if ((p < bytes) && (p % segment == 0)) start_row[p/segment] = row;
+    if (p > 0) symbols[k++] = data[p-1];
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+bool BWT_Codec::inverse(unsigned bytes,
+                        unsigned walks,
+                        const unsigned start_row[],
+                        unsigned char * data)
+{                    // false if segments do not lead back to their start rows
+  const unsigned char * last = symbols;
+  unsigned count[256], first[256], primary = start_row[0];
+  memset(count, 0, sizeof(count));
+  for (unsigned p = 0; p < bytes; p++) count[last[p]]++;
+  for (unsigned c = 0, sum = 1; c < 256; c++) {     // row 0: terminator first
+    first[c] = sum;
+    sum += count[c];
+  }
+  int * link = suffix;               // row of the preceding rotation, in high
+  for (unsigned row = 0, k = 0; row <= bytes; row++)     // bits, and row byte
+    if (row == primary)                                      // in the 8 LSBs:
+      link[row] = 0;                             // one memory access per byte
+    else {
+      unsigned c = last[k++];
+      link[row] = int((first[c]++ << 8) | c);
+    }
+                        // each segment is rebuilt from its end; walks through
+  unsigned row[BWT__Walks], end[BWT__Walks];  // the table are independent, so
+  unsigned segment = BWT_Segment(bytes, walks);    // memory reads can overlap
+  for (unsigned w = 0; w < walks; w++) {
+    row[w] = (w + 1 < walks ? start_row[w+1] : 0);
+    end[w] = (w + 1 < walks ? (w + 1) * segment : bytes);
+  }
+  for (unsigned n = 0; n < segment; n++)
+    for (unsigned w = 0; w < walks; w++)
+      if (end[w] > w * segment) {
+        unsigned entry = unsigned(link[row[w]]);
+        data[--end[w]] = (unsigned char) entry;
+        row[w] = entry >> 8;
+      }
+  for (unsigned w = 0; w < walks; w++)
+    if (row[w] != start_row[w]) return false;
+  return true;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
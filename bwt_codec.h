@@ -0,0 +1,94 @@
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+//                       ****************************                        -
+//                        ARITHMETIC CODING EXAMPLES                         -
+//                       ****************************                        -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+// Block-sorting (BWT) coding of data blocks with arithmetic coding          -
+// -> SA-IS suffix sorting, move-to-front ranks, and parallel inverse        -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+// Version 1.00  -  October 19, 2026                                         -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+//                                  WARNING                                  -
+//                                 =========                                 -
+//                                                                           -
+// The only purpose of this program is to demonstrate the basic principles   -
+// of arithmetic coding. It is provided as is, without any express or        -
+// implied warranty, without even the warranty of fitness for any particular -
+// purpose, or that the implementations are correct.                         -
+//                                                                           -
+// Permission to copy and redistribute this code is hereby granted, provided -
+// that this warning and copyright notices are not removed or altered.       -
+//                                                                           -
+// Copyright (c) 2026 by the FastAC contributors                             -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+
+// - - Definitions - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#ifndef BWT_CODEC
+#define BWT_CODEC
+
+#include "context_model.h"
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// - - Class definition  - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+        // Codes a block of bytes with the Burrows-Wheeler transform: the last
+   // column of its sorted rotations, with a terminator, found by SA-IS suffix
+        // sorting. Its move-to-front ranks are coded as tokens: a run of zero
+      // ranks, or the magnitude class (1 to 8) of a rank, with the bits below
+    // its leading 1 coded by a tree of adaptive bit models. Token classes are
+      // coded with the Context_Model of previous classes. Large blocks have 8
+          // segments, which the decoder inverts with interleaved table walks.
+   // Blocks must be smaller than 16 MB: the inverse transform packs a row and
+                                         // a byte in each 32-bit table entry.
+
+class BWT_Codec
+{
+public:
+
+  BWT_Codec(void);
+ ~BWT_Codec(void);
+
+  void reset(void);                       // each block starts with new models
+
+  void encode(Arithmetic_Codec & codec,        // codec is started, and models
+              Context_Model & classes,        // of rank classes reset, by the
+              const unsigned char data[],                            // caller
+              unsigned number_of_bytes);                         // below 2^24
+  void decode(Arithmetic_Codec & codec,
+              Context_Model & classes,
+              unsigned char data[],
+              unsigned number_of_bytes);
+
+private:  //  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .
+  void reserve(unsigned block_bytes,                   // buffers for a block;
+               bool encoder);                   // encoder needs text copy too
+  void forward(const unsigned char * data,
+               unsigned bytes,
+               unsigned walks,
+               unsigned start_row[]);
+  bool inverse(unsigned bytes,
+               unsigned walks,
+               const unsigned start_row[],
+               unsigned char * data);
+  Adaptive_Integer_Model run_length;            // of zero move-to-front ranks
+  Adaptive_Bit_Model     rank_bits[9][128];   // trees of rank bits, per class
+  unsigned char  * symbols;          // transformed block, before or after MTF
+  int            * suffix;               // suffix array, or inverse transform
+  unsigned short * text;                        // block + 1, and 0 terminator
+  unsigned capacity, text_capacity;
+};
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#endif
@@ -0,0 +1,194 @@
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+//                       ****************************                        -
+//                        ARITHMETIC CODING EXAMPLES                         -
+//                       ****************************                        -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+// Data checksums for the file compression examples                          -
+// -> legacy table CRC, and CRC32C with SSE4.2 instruction when available    -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+// Version 1.00  -  October 19, 2026                                         -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+//                                  WARNING                                  -
+//                                 =========                                 -
+//                                                                           -
+// The only purpose of this program is to demonstrate the basic principles   -
+// of arithmetic coding. It is provided as is, without any express or        -
+// implied warranty, without even the warranty of fitness for any particular -
+// purpose, or that the implementations are correct.                         -
+//                                                                           -
+// Permission to copy and redistribute this code is hereby granted, provided -
+// that this warning and copyright notices are not removed or altered.       -
+//                                                                           -
+// Copyright (c) 2026 by the FastAC contributors                             -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+
+// - - Inclusion - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#include <string.h>
+#include "checksum.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define CRC32C_SSE42
+#define CRC32C_TARGET __attribute__((target("sse4.2")))
+#include <nmmintrin.h>
+#endif
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1500) &&                               \
+    (defined(_M_X64) || defined(_M_IX86))
+#define CRC32C_SSE42
+#define CRC32C_TARGET
+#include <intrin.h>
+#include <nmmintrin.h>
+#endif
+
+
+// - - Constants - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+const unsigned CRC__Generator[8] = {             // generates legacy CRC table
+  0xEC1A5A3EU, 0x5975F5D7U, 0xB2EBEBAEU, 0xE49696F7U,
+  0x486C6C45U, 0x90D8D88AU, 0xA0F0F0BFU, 0xC0A0A0D5U };
+
+const unsigned CRC__Castagnoli = 0x82F63B78U;   // reflected CRC32C polynomial
+
+
+// - - Static data - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+typedef unsigned CRC_Function(unsigned, const unsigned char *, unsigned);
+
+static struct CRC_Tables               // filled before main(), so threads can
+{                                       // compute checksums without any locks
+  CRC_Tables(void);
+  unsigned legacy[256];
+  unsigned slice[8][256];                    // slicing-by-8 tables for CRC32C
+  CRC_Function * crc32c;                // fastest CRC32C version for this CPU
+} CRC__Tables;
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// - - Static functions  - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+static inline unsigned CRC_Word(const unsigned char * b)
+{                                         // little-endian word, any alignment
+  return unsigned(b[0]) | (unsigned(b[1]) << 8) |
+        (unsigned(b[2]) << 16) | (unsigned(b[3]) << 24);
+}
+
+static unsigned CRC32C_Software(unsigned crc,
+                                const unsigned char * buffer,
+                                unsigned bytes)
+{
+  const unsigned (* t)[256] = CRC__Tables.slice;        // slicing-by-8: eight
+  for (; bytes >= 8; bytes -= 8, buffer += 8) {         // bytes per iteration
+    unsigned a = crc ^ CRC_Word(buffer), b = CRC_Word(buffer + 4);
+    crc = t[7][a&0xFFU] ^ t[6][(a>>8)&0xFFU] ^ t[5][(a>>16)&0xFFU] ^
+          t[4][a>>24] ^ t[3][b&0xFFU] ^ t[2][(b>>8)&0xFFU] ^
+          t[1][(b>>16)&0xFFU] ^ t[0][b>>24];
+  }
+  while (bytes--) crc = (crc >> 8) ^ t[0][(crc^unsigned(*buffer++))&0xFFU];
+  return crc;
+}
+
+#ifdef CRC32C_SSE42
+
+CRC32C_TARGET static unsigned CRC32C_SSE42_Instruction(unsigned crc,
+                                              const unsigned char * buffer,
+                                              unsigned bytes)
+{
+#if defined(__x86_64__) || defined(_M_X64)
+  unsigned long long c = crc, w;                // eight bytes per instruction
+  for (; bytes >= 8; bytes -= 8, buffer += 8) {
+    memcpy(&w, buffer, 8);
+    c = _mm_crc32_u64(c, w);
+  }
+  crc = unsigned(c);
+#endif
+  for (unsigned w; bytes >= 4; bytes -= 4, buffer += 4) {
+    memcpy(&w, buffer, 4);
+    crc = _mm_crc32_u32(crc, w);
+  }
+  while (bytes--) crc = _mm_crc32_u8(crc, *buffer++);
+  return crc;
+}
+
+static bool CPU_Has_SSE42(void)
+{
+#if defined(__GNUC__)
+  __builtin_cpu_init();                  // required when used by constructors
+  return __builtin_cpu_supports("sse4.2") != 0;
+#else
+  int info[4];
+  __cpuid(info, 1);
+  return (info[2] & (1 << 20)) != 0;
+#endif
+}
+
+#endif
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// - - Implementations - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+CRC_Tables::CRC_Tables(void)
+{
+  legacy[0] = 0;                                       // compute legacy table
+  for (unsigned k = 0; k < 8; k++) {
+    unsigned s = 1 << k, g = CRC__Generator[k];
+    for (unsigned n = 0; n < s; n++) legacy[n+s] = legacy[n] ^ g;
+  }
+                                                      // compute CRC32C tables
+  for (unsigned n = 0; n < 256; n++) {
+    unsigned c = n;
+    for (unsigned k = 0; k < 8; k++)
+      c = (c >> 1) ^ (c & 1 ? CRC__Castagnoli : 0);
+    slice[0][n] = c;
+  }
+  for (unsigned n = 0; n < 256; n++)
+    for (unsigned k = 1; k < 8; k++)
+      slice[k][n] = (slice[k-1][n] >> 8) ^ slice[0][slice[k-1][n]&0xFFU];
+
+  crc32c = CRC32C_Software;                          // choose version for CPU
+#ifdef CRC32C_SSE42
+  if (CPU_Has_SSE42()) crc32c = CRC32C_SSE42_Instruction;
+#endif
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+unsigned Buffer_CRC(unsigned bytes,
+                    const unsigned char * buffer)
+{
+                                  // computes buffer's cyclic redundancy check
+  unsigned crc = 0;
+  if (bytes)
+    do {
+      crc = (crc >> 8) ^ CRC__Tables.legacy[(crc&0xFFU)^unsigned(*buffer++)];
+    } while (--bytes);
+  return crc;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+unsigned CRC32C(unsigned bytes,
+                const unsigned char * buffer,
+                unsigned crc)
+{
+  return ~CRC__Tables.crc32c(~crc, buffer, bytes);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+bool CRC32C_Hardware(void)
+{
+  return CRC__Tables.crc32c != CRC32C_Software;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
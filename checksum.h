@@ -0,0 +1,55 @@
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+//                       ****************************                        -
+//                        ARITHMETIC CODING EXAMPLES                         -
+//                       ****************************                        -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+// Data checksums for the file compression examples                          -
+// -> legacy table CRC, and CRC32C with SSE4.2 instruction when available    -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+// Version 1.00  -  October 19, 2026                                         -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+//                                  WARNING                                  -
+//                                 =========                                 -
+//                                                                           -
+// The only purpose of this program is to demonstrate the basic principles   -
+// of arithmetic coding. It is provided as is, without any express or        -
+// implied warranty, without even the warranty of fitness for any particular -
+// purpose, or that the implementations are correct.                         -
+//                                                                           -
+// Permission to copy and redistribute this code is hereby granted, provided -
+// that this warning and copyright notices are not removed or altered.       -
+//                                                                           -
+// Copyright (c) 2026 by the FastAC contributors                             -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+
+// - - Definitions - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#ifndef DATA_CHECKSUM
+#define DATA_CHECKSUM
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// - - Prototypes  - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+unsigned Buffer_CRC(unsigned bytes,                     // original table CRC,
+                    const unsigned char * buffer);   // kept to read old files
+
+unsigned CRC32C(unsigned bytes,                    // CRC32C (Castagnoli), use
+                const unsigned char * buffer,    // previous value to continue
+                unsigned crc = 0);
+
+bool CRC32C_Hardware(void);                 // true if using crc32 instruction
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#endif
@@ -0,0 +1,107 @@
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+//                       ****************************                        -
+//                        ARITHMETIC CODING EXAMPLES                         -
+//                       ****************************                        -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+// Adaptive byte models selected by the previous bytes of the data           -
+// -> order 0, 1, or 2 contexts, with 1 to 2^16 models reset on first use    -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+// Version 1.00  -  October 19, 2026                                         -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+//                                  WARNING                                  -
+//                                 =========                                 -
+//                                                                           -
+// The only purpose of this program is to demonstrate the basic principles   -
+// of arithmetic coding. It is provided as is, without any express or        -
+// implied warranty, without even the warranty of fitness for any particular -
+// purpose, or that the implementations are correct.                         -
+//                                                                           -
+// Permission to copy and redistribute this code is hereby granted, provided -
+// that this warning and copyright notices are not removed or altered.       -
+//                                                                           -
+// Copyright (c) 2026 by the FastAC contributors                             -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+
+// - - Inclusion - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "context_model.h"
+
+
+// - - Constants - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+const unsigned CM__MaxBits = 16;                  // 2^16 models: about 150 MB
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// - - Static functions  - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+static void CM_Error(const char * msg)
+{
+  fprintf(stderr, "\n\n -> Context model error: ");
+  fputs(msg, stderr);
+  fputs("\n Execution terminated!\n", stderr);
+  exit(1);
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// - - Context model implementation  - - - - - - - - - - - - - - - - - - - - -
+
+Context_Model::Context_Model(unsigned order,
+                             unsigned bits)
+{
+  if ((order > 2) || ((order == 0) && bits) || ((order != 0) && !bits) ||
+      (bits > (order == 1 ? 8 : CM__MaxBits)))
+    CM_Error("invalid context order or number of bits");
+
+  models = 1U << bits;          // order 0 has one model, with 0 bits; order 1
+  multiplier = 1;             // uses low bits of last byte; order 2 uses high
+  shift = 0;                                     // bits of the hashed 2 bytes
+  switch (order) {
+    case 0: history_mask = 0; break;
+    case 1: history_mask = models - 1; break;
+    default: history_mask = 0xFFFFU;
+             multiplier = 0x9E3779B1U;
+             shift = 32 - bits;
+  }
+  dm = new Adaptive_Data_Model[models];
+  epoch = new unsigned[models];
+  if ((dm == 0) || (epoch == 0)) CM_Error("cannot assign model memory");
+  for (unsigned m = 0; m < models; m++) {
+    dm[m].set_alphabet(256);
+    epoch[m] = 0;
+  }
+  current_epoch = 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+Context_Model::~Context_Model(void)
+{
+  delete [] epoch;
+  delete [] dm;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void Context_Model::reset(void)
+{
+  if (++current_epoch == 0)                        // rare wrap: reset all now
+    for (unsigned m = 0; m < models; m++) {
+      dm[m].reset();
+      epoch[m] = 0;
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
@@ -0,0 +1,83 @@
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+//                       ****************************                        -
+//                        ARITHMETIC CODING EXAMPLES                         -
+//                       ****************************                        -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+// Adaptive byte models selected by the previous bytes of the data           -
+// -> order 0, 1, or 2 contexts, with 1 to 2^16 models reset on first use    -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+// Version 1.00  -  October 19, 2026                                         -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+//                                  WARNING                                  -
+//                                 =========                                 -
+//                                                                           -
+// The only purpose of this program is to demonstrate the basic principles   -
+// of arithmetic coding. It is provided as is, without any express or        -
+// implied warranty, without even the warranty of fitness for any particular -
+// purpose, or that the implementations are correct.                         -
+//                                                                           -
+// Permission to copy and redistribute this code is hereby granted, provided -
+// that this warning and copyright notices are not removed or altered.       -
+//                                                                           -
+// Copyright (c) 2026 by the FastAC contributors                             -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+
+
+// - - Definitions - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#ifndef CONTEXT_MODEL
+#define CONTEXT_MODEL
+
+#include "arithmetic_codec.h"
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// - - Class definition  - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+    // Set of Adaptive_Data_Model for 256 symbols, one of them selected by the
+   // bytes that precede the next one. Order 0 has one model; order 1 uses the
+     // low 'bits' of the previous byte; order 2 uses the top 'bits' of a hash
+      // of the last two bytes. reset() only starts a new epoch: each model is
+      // reset when first used after it, so many models cost little per block.
+                                        // LZ77 and BWT coders use it as well.
+
+class Context_Model
+{
+public:
+
+  Context_Model(unsigned order,                         // 0, 1 (bits up to 8)
+                unsigned bits);                             // or 2 (up to 16)
+ ~Context_Model(void);
+
+  unsigned model_count(void) { return models; }
+
+  void reset(void);                        // models are reset on next use, so
+                                             // cost is small with many models
+  Adaptive_Data_Model & operator [] (unsigned history)  // last byte in 8 LSBs
+  {
+    unsigned m = ((history & history_mask) * multiplier) >> shift;
+    if (epoch[m] != current_epoch) {
+      epoch[m] = current_epoch;
+      dm[m].reset();
+    }
+    return dm[m];
+  }
+
+private:  //  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .
+  Adaptive_Data_Model * dm;
+  unsigned * epoch, current_epoch;
+  unsigned models, history_mask, multiplier, shift;
+};
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#endif
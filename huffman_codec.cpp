@@ -0,0 +1,362 @@
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+//                       ****************************                        -
+//                        ARITHMETIC CODING EXAMPLES                         -
+//                       ****************************                        -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+// Canonical Huffman coding of blocks with static model distributions        -
+// -> arithmetic coding instead when the Huffman code is too redundant       -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+// Version 1.00  -  October 19, 2026                                         -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+//                                  WARNING                                  -
+//                                 =========                                 -
+//                                                                           -
+// The only purpose of this program is to demonstrate the basic principles   -
+// of arithmetic coding. It is provided as is, without any express or        -
+// implied warranty, without even the warranty of fitness for any particular -
+// purpose, or that the implementations are correct.                         -
+//                                                                           -
+// Permission to copy and redistribute this code is hereby granted, provided -
+// that this warning and copyright notices are not removed or altered.       -
+//                                                                           -
+// Copyright (c) 2026 by the FastAC contributors                             -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+
+
+// - - Inclusion - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "huffman_codec.h"
+
+
+// - - Constants - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+const unsigned HC__MaxLength  = 12;                // longest Huffman codeword
+const unsigned HC__MaxSymbols = 1 << 11;
+const unsigned HC__Streams    = 4;          // interleaved Huffman bit streams
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// - - Static functions  - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+static void HC_Error(const char * msg)
+{
+  fprintf(stderr, "\n\n -> Huffman coding error: ");
+  fputs(msg, stderr);
+  fputs("\n Execution terminated!\n", stderr);
+  exit(1);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+static int HC_Compare(const void * a, const void * b)
+{
+  unsigned x = *(const unsigned *) a, y = *(const unsigned *) b;
+  return (x < y ? -1 : (x > y ? 1 : 0));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+static inline unsigned long long HC_Load(const unsigned char * p,
+                                         const unsigned char * end)
+{                      // big-endian 64-bit word, zeros after the buffer's end
+  unsigned long long w = 0;
+  if (p + 8 <= end) {
+#if defined(__GNUC__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+    memcpy(&w, p, 8);
+    return __builtin_bswap64(w);
+#elif defined(_MSC_VER) && (_MSC_VER >= 1400)
+    memcpy(&w, p, 8);
+    return _byteswap_uint64(w);
+#else
+    for (unsigned k = 0; k < 8; k++) w = (w << 8) | p[k];
+    return w;
+#endif
+  }
+  if (p > end) HC_Error("code buffer overflow");
+  for (unsigned k = 0; k < 8; k++)
+    w = (w << 8) | (p + k < end ? p[k] : 0);
+  return w;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+static inline unsigned short HC_Decode(const unsigned short * decoder_table,
+                                       unsigned shift,
+                                       unsigned long long & bits,
+                                       unsigned & used)
+{                        // table entry: symbol and codeword length, in 4 bits
+  unsigned e = decoder_table[unsigned(bits >> shift)];
+  bits <<= e & 0xFU;                          // next codeword in the top bits
+  used += e & 0xFU;
+  return (unsigned short) (e >> 4);
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// - - Implementations - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+Huffman_Codec::Huffman_Codec(void)
+{
+  buffer_size = data_symbols = table_bits = 0;
+  new_buffer = code_buffer = 0;
+  code_table = node_weight = 0;
+  decoder_table = 0;
+  model = 0;
+  huffman_redundancy = 0;
+  use_huffman = false;
+}
+
+Huffman_Codec::Huffman_Codec(unsigned max_code_bytes,
+                             unsigned char * user_buffer)
+{
+  buffer_size = data_symbols = table_bits = 0;
+  new_buffer = code_buffer = 0;
+  code_table = node_weight = 0;
+  decoder_table = 0;
+  model = 0;
+  huffman_redundancy = 0;
+  use_huffman = false;
+  set_buffer(max_code_bytes, user_buffer);
+}
+
+Huffman_Codec::~Huffman_Codec(void)
+{
+  delete [] new_buffer;
+  delete [] code_table;
+  delete [] decoder_table;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void Huffman_Codec::set_buffer(unsigned max_code_bytes,
+                               unsigned char * user_buffer)
+{
+                                                  // test for reasonable sizes
+  if ((max_code_bytes < 16) || (max_code_bytes > 0x1000000U))
+    HC_Error("invalid codec buffer size");
+
+  if (user_buffer != 0) {                       // user provides memory buffer
+    buffer_size = max_code_bytes;
+    code_buffer = user_buffer;               // set buffer for compressed data
+    delete [] new_buffer;                 // free anything previously assigned
+    new_buffer = 0;
+  }
+  else
+    if ((new_buffer == 0) || (max_code_bytes > buffer_size)) {
+      buffer_size = max_code_bytes;                       // assign new memory
+      delete [] new_buffer;               // free anything previously assigned
+      if ((new_buffer = new unsigned char[buffer_size+16]) == 0)   // 16 extra
+        HC_Error("cannot assign memory for compressed data buffer");
+      code_buffer = new_buffer;              // set buffer for compressed data
+    }
+                                // arithmetic coding fallback uses same buffer
+  codec.set_buffer(buffer_size, code_buffer);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void Huffman_Codec::set_model(Static_Data_Model & M,
+                              double max_redundancy)
+{
+  if (M.data_symbols == 0) HC_Error("static model not set");
+
+  if (code_table == 0) {                    // tables for the largest alphabet
+    code_table    = new unsigned[5*HC__MaxSymbols];
+    decoder_table = new unsigned short[1<<HC__MaxLength];
+    if ((code_table == 0) || (decoder_table == 0))
+      HC_Error("cannot assign Huffman table memory");
+    node_weight = code_table + HC__MaxSymbols;
+  }
+
+  model = &M;
+  data_symbols = M.data_symbols;
+  unsigned * node_parent = node_weight + 2 * HC__MaxSymbols;
+  unsigned s, k, n = data_symbols, bits = M.length_shift;
+                             // sort symbols by probability, symbol in 11 bits
+  for (s = 0; s < n; s++) {
+    unsigned end = (s == M.last_symbol ? 1U << bits : M.distribution[s+1]);
+    node_weight[s] = ((end - M.distribution[s]) << 11) | s;
+  }
+  qsort(node_weight, n, sizeof(unsigned), HC_Compare);
+  for (k = 0; k < n; k++) {
+    code_table[node_weight[k]&0x7FFU] = k;        // symbol -> sorted position
+    node_weight[k] >>= 11;
+  }
+                       // Huffman tree: leaves and new nodes are both in order
+  unsigned leaf = 0, node = n;
+  for (k = n; k < 2 * n - 1; k++) {
+    unsigned child[2];
+    for (unsigned c = 0; c < 2; c++)
+      if ((leaf < n) &&
+          ((node == k) || (node_weight[leaf] <= node_weight[node])))
+        child[c] = leaf++;
+      else
+        child[c] = node++;
+    node_weight[k] = node_weight[child[0]] + node_weight[child[1]];
+    node_parent[child[0]] = node_parent[child[1]] = k;
+  }
+                                    // codeword lengths = depths of the leaves
+  node_parent[2*n-2] = 0;
+  for (k = 2 * n - 2; k-- > 0; )
+    node_parent[k] = node_parent[node_parent[k]] + 1;
+
+                           // limit lengths, then restore the Kraft inequality
+  unsigned capacity = 1U << HC__MaxLength, kraft = 0;
+  for (k = 0; k < n; k++) {
+    if (node_parent[k] > HC__MaxLength) node_parent[k] = HC__MaxLength;
+    kraft += capacity >> node_parent[k];
+  }
+  while (kraft > capacity)                // lengthen least probable codewords
+    for (k = 0; (k < n) && (kraft > capacity); k++)
+      if (node_parent[k] < HC__MaxLength)
+        kraft -= capacity >> ++node_parent[k];
+  for (k = n; k-- > 0; )                    // shorten most probable codewords
+    while ((node_parent[k] > 1) &&
+           (kraft + (capacity >> node_parent[k]) <= capacity))
+      kraft += capacity >> node_parent[k]--;
+
+                                // redundancy of the code with model's entropy
+  double entropy = 0, average = 0;
+  table_bits = 0;
+  for (s = 0; s < n; s++) {
+    unsigned end = (s == M.last_symbol ? 1U << bits : M.distribution[s+1]);
+    double p = double(end - M.distribution[s]) / double(1U << bits);
+    unsigned length = node_parent[code_table[s]];
+    entropy -= p * log(p) / log(2.0);
+    average += p * length;
+    code_table[s] = length;
+    if (length > table_bits) table_bits = length;
+  }
+  huffman_redundancy = (average - entropy) / entropy;
+  use_huffman = (huffman_redundancy <= max_redundancy);
+  if (!use_huffman) return;
+                       // canonical codewords: by length, then by symbol order
+  unsigned length_count[HC__MaxLength+1], next_code[HC__MaxLength+1];
+  unsigned code = 0;
+  memset(length_count, 0, sizeof(length_count));
+  for (s = 0; s < n; s++) ++length_count[code_table[s]];
+  for (k = 1; k <= HC__MaxLength; k++) {
+    next_code[k] = code;
+    code = (code + length_count[k]) << 1;
+  }
+  for (s = 0; s < n; s++) {                // codeword in 12 bits, length in 4
+    unsigned length = code_table[s];
+    code = next_code[length]++;
+    code_table[s] = (code << 4) | length;
+    unsigned first = code << (table_bits - length);
+    for (k = 0; k < (1U << (table_bits - length)); k++)
+      decoder_table[first+k] = (unsigned short) ((s << 4) | length);
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+unsigned Huffman_Codec::encode(const unsigned short data[],
+                               unsigned symbols)
+{
+  if (data_symbols == 0) HC_Error("model not set");
+  if (buffer_size == 0) HC_Error("no code buffer set");
+
+  unsigned k;
+  if (!use_huffman) {
+    codec.start_encoder();
+    for (k = 0; k < symbols; k++) codec.encode(data[k], *model);
+    return codec.stop_encoder();
+  }
+                      // symbol k goes to stream k % 4; streams are written in
+                     // order, after the byte sizes of the first three streams
+  unsigned char * p = code_buffer + 4 * (HC__Streams - 1);
+  unsigned char * end = code_buffer + buffer_size;
+  for (unsigned j = 0; j < HC__Streams; j++) {
+    unsigned long long bits = 0;                       // bits not written yet
+    unsigned count = 0;
+    unsigned char * start = p;
+    for (k = j; k < symbols; k += HC__Streams) {
+#ifdef _DEBUG
+      if (data[k] >= data_symbols) HC_Error("invalid data symbol");
+#endif
+      unsigned e = code_table[data[k]], n = e & 0xFU;
+      bits = (bits << n) | (e >> 4);
+      count += n;
+      if (count >= 32) {                                      // write 4 bytes
+        if (p + 4 > end) HC_Error("code buffer overflow");
+        for (unsigned b = 0; b < 4; b++, count -= 8)
+          *p++ = (unsigned char) (bits >> (count - 8));
+      }
+    }
+    for (; count > 0; count = (count > 8 ? count - 8 : 0)) { // pad with zeros
+      if (p == end) HC_Error("code buffer overflow");
+      *p++ = (unsigned char) (count >= 8 ? bits >> (count - 8) :
+                                           bits << (8 - count));
+    }
+    if (j == HC__Streams - 1) break;
+    unsigned stream_bytes = unsigned(p - start);
+    for (unsigned b = 0; b < 4; b++)
+      code_buffer[4*j+b] = (unsigned char) (stream_bytes >> (24 - 8 * b));
+  }
+
+  return unsigned(p - code_buffer);                    // number of bytes used
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void Huffman_Codec::decode(unsigned short data[],
+                           unsigned symbols)
+{
+  if (data_symbols == 0) HC_Error("model not set");
+  if (buffer_size == 0) HC_Error("no code buffer set");
+
+  unsigned j, k = 0;
+  if (!use_huffman) {
+    codec.start_decoder();
+    for (; k < symbols; k++) data[k] = (unsigned short) codec.decode(*model);
+    codec.stop_decoder();
+    return;
+  }
+                        // find the start of each stream from the stream sizes
+  const unsigned char * p[HC__Streams], * end = code_buffer + buffer_size;
+  p[0] = code_buffer + 4 * (HC__Streams - 1);
+  for (j = 0; j < HC__Streams - 1; j++) {
+    const unsigned char * h = code_buffer + 4 * j;
+    p[j+1] = p[j] + ((unsigned(h[0]) << 24) | (unsigned(h[1]) << 16) |
+                     (unsigned(h[2]) << 8) | unsigned(h[3]));
+    if ((p[j+1] < p[j]) || (p[j+1] > end)) HC_Error("invalid Huffman code");
+  }
+
+  const unsigned short * table = decoder_table;
+  unsigned long long bits[HC__Streams];
+  unsigned used[HC__Streams], shift = 64 - table_bits;
+  for (j = 0; j < HC__Streams; j++) used[j] = 0;
+                     // 4 independent streams, so lookups overlap; 4 codewords
+  for (; k + 16 <= symbols; k += 16) {   // use at most 48 bits: one load each
+    for (j = 0; j < HC__Streams; j++) {
+      p[j] += used[j] >> 3;
+      used[j] &= 7;
+      bits[j] = HC_Load(p[j], end) << used[j];
+    }
+    for (unsigned i = 0; i < 16; i += HC__Streams)
+      for (j = 0; j < HC__Streams; j++)
+        data[k+i+j] = HC_Decode(table, shift, bits[j], used[j]);
+  }
+  for (; k < symbols; k++) {
+    j = k & (HC__Streams - 1);
+    p[j] += used[j] >> 3;
+    used[j] &= 7;
+    bits[j] = HC_Load(p[j], end) << used[j];
+    data[k] = HC_Decode(table, shift, bits[j], used[j]);
+  }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
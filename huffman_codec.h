@@ -0,0 +1,94 @@
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+//                       ****************************                        -
+//                        ARITHMETIC CODING EXAMPLES                         -
+//                       ****************************                        -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+// Canonical Huffman coding of blocks with static model distributions        -
+// -> arithmetic coding instead when the Huffman code is too redundant       -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+// Version 1.00  -  October 19, 2026                                         -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+//                                  WARNING                                  -
+//                                 =========                                 -
+//                                                                           -
+// The only purpose of this program is to demonstrate the basic principles   -
+// of arithmetic coding. It is provided as is, without any express or        -
+// implied warranty, without even the warranty of fitness for any particular -
+// purpose, or that the implementations are correct.                         -
+//                                                                           -
+// Permission to copy and redistribute this code is hereby granted, provided -
+// that this warning and copyright notices are not removed or altered.       -
+//                                                                           -
+// Copyright (c) 2026 by the FastAC contributors                             -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+
+
+// - - Definitions - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#ifndef HUFFMAN_CODEC
+#define HUFFMAN_CODEC
+
+#include "arithmetic_codec.h"
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// - - Class definition  - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+ // Codes whole blocks of symbols from a Static_Data_Model. set_model() builds
+   // a canonical Huffman code (at most 12 bits per codeword) and measures its
+    // redundancy against the model's entropy. When it is below max_redundancy
+      // the block is coded with Huffman codes, and each decoded symbol is one
+      // lookup in a table of 2^(longest codeword) entries. Otherwise, as with
+    // skewed distributions, the block is coded with Arithmetic_Codec. Encoder
+ // and decoder choose the same way from the same model, so nothing is stored.
+
+class Huffman_Codec
+{
+public:
+
+  Huffman_Codec(void);
+ ~Huffman_Codec(void);
+  Huffman_Codec(unsigned max_code_bytes,
+                unsigned char * user_buffer = 0);            // 0 = assign new
+
+  unsigned char * buffer(void) { return code_buffer; }
+
+  void set_buffer(unsigned max_code_bytes,
+                  unsigned char * user_buffer = 0);          // 0 = assign new
+
+  void set_model(Static_Data_Model &,             // model must not change, or
+                 double max_redundancy = 0.01);    // be deleted, while in use
+
+  bool   huffman(void)    { return use_huffman; }   // false = arithmetic code
+  double redundancy(void) { return huffman_redundancy; }    // relative to the
+                                                            // model's entropy
+  unsigned encode(const unsigned short data[],      // returns number of bytes
+                  unsigned number_of_symbols);             // used in buffer()
+  void     decode(unsigned short data[],
+                  unsigned number_of_symbols);
+
+private:  //  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .
+  unsigned char * code_buffer, * new_buffer;
+  unsigned * code_table;                    // per symbol: codeword and length
+  unsigned * node_weight;                         // Huffman tree construction
+  unsigned short * decoder_table;        // per code prefix: symbol and length
+  Static_Data_Model * model;
+  Arithmetic_Codec codec;
+  double huffman_redundancy;
+  bool use_huffman;
+  unsigned buffer_size, data_symbols, table_bits;
+};
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#endif
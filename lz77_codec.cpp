@@ -0,0 +1,296 @@
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+//                       ****************************                        -
+//                        ARITHMETIC CODING EXAMPLES                         -
+//                       ****************************                        -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+// LZ77 coding of data blocks with adaptive arithmetic coding                -
+// -> hash-chain match finder, recent distances, and lazy matching           -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+// Version 1.00  -  October 19, 2026                                         -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+//                                  WARNING                                  -
+//                                 =========                                 -
+//                                                                           -
+// The only purpose of this program is to demonstrate the basic principles   -
+// of arithmetic coding. It is provided as is, without any express or        -
+// implied warranty, without even the warranty of fitness for any particular -
+// purpose, or that the implementations are correct.                         -
+//                                                                           -
+// Permission to copy and redistribute this code is hereby granted, provided -
+// that this warning and copyright notices are not removed or altered.       -
+//                                                                           -
+// Copyright (c) 2026 by the FastAC contributors                             -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+
+// - - Inclusion - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "lz77_codec.h"
+
+
+// - - Constants - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+const unsigned LZ__MinMatch        = 4;    // shortest match, and bytes hashed
+const unsigned LZ__NiceMatch       = 128;       // long enough: stop searching
+const unsigned LZ__ChainSteps      = 24;  // earlier positions tried per match
+const unsigned LZ__RecentDistances = 4;   // repeated distances, cheap to code
+const unsigned LZ__MaxHashBits     = 20;    // hash table: 1 entry per 4 bytes
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// - - Static functions  - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+static void LZ_Error(const char * msg)
+{
+  fprintf(stderr, "\n\n -> LZ77 coding error: ");
+  fputs(msg, stderr);
+  fputs("\n Execution terminated!\n", stderr);
+  exit(1);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+static inline unsigned LZ_Hash(const unsigned char * b,
+                               unsigned shift)
+{                                            // multiplicative hash of 4 bytes
+  unsigned word = unsigned(b[0]) | (unsigned(b[1]) << 8) |
+                  (unsigned(b[2]) << 16) | (unsigned(b[3]) << 24);
+  return (word * 0x9E3779B1U) >> shift;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+static inline unsigned LZ_Previous_Bytes(const unsigned char * data,
+                                         unsigned position)
+{                           // literal context, as if all bytes had been coded
+  return (position > 1 ? unsigned(data[position-2]) << 8 : 0) |
+         (position > 0 ? unsigned(data[position-1]) : 0);
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// - - LZ77 codec implementation - - - - - - - - - - - - - - - - - - - - - - -
+
+LZ77_Codec::LZ77_Codec(void)
+{
+  distance.set_contexts(2, false, 3);         // context: last token was match
+  length.set_contexts(2, false, 2);       // context: repeated or new distance
+  for (unsigned n = 0; n < LZ__RecentDistances; n++) recent[n] = 0;
+  data = 0;
+  bytes = chain_size = 0;
+  head = chain = 0;                      // hash tables only needed by encoder
+  base = 1;
+  hash_shift = 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+LZ77_Codec::~LZ77_Codec(void)
+{
+  delete [] head;
+  delete [] chain;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void LZ77_Codec::reset(void)
+{
+  for (unsigned n = 0; n < 4; n++) match_flag[n].reset();
+  distance.reset();
+  length.reset();
+  for (unsigned n = 0; n < LZ__RecentDistances; n++) recent[n] = 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void LZ77_Codec::encode(Arithmetic_Codec & codec,
+                        Context_Model & literals,
+                        const unsigned char block[],
+                        unsigned block_bytes)
+{
+  start_search(block, block_bytes);
+
+  unsigned p = 0, tokens = 0, match_distance = 0;   // tokens: 1 bit per match
+  unsigned match_length = find_match(0, match_distance);
+  while (p < block_bytes) {
+    insert(p);
+    if (match_length && (match_length < LZ__NiceMatch)) {  // lazy matching: a
+      unsigned next_distance = 0;     // literal, if next byte starts a longer
+      unsigned next = find_match(p + 1, next_distance);               // match
+      if (next > match_length) {
+        codec.encode(0, match_flag[tokens]);
+        codec.encode(block[p], literals[LZ_Previous_Bytes(block, p)]);
+        tokens = (tokens << 1) & 3;
+        p++;
+        match_length = next;
+        match_distance = next_distance;
+        continue;
+      }
+    }
+    if (match_length) {         // match: distance or its recent index, length
+      unsigned r = recent_index(match_distance);
+      unsigned repeat = (r < LZ__RecentDistances);
+      codec.encode(1, match_flag[tokens]);
+      codec.encode(int(repeat ? r : match_distance + LZ__RecentDistances - 1),
+                   distance, tokens & 1);
+      codec.encode(int(match_length - LZ__MinMatch), length, repeat);
+      use_distance(r, match_distance);
+      tokens = ((tokens << 1) | 1) & 3;
+      for (unsigned q = p + 1; q < p + match_length; q++) insert(q);
+      p += match_length;
+    }
+    else {                                  // literal, coded by context model
+      codec.encode(0, match_flag[tokens]);
+      codec.encode(block[p], literals[LZ_Previous_Bytes(block, p)]);
+      tokens = (tokens << 1) & 3;
+      p++;
+    }
+    match_length = find_match(p, match_distance);
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void LZ77_Codec::decode(Arithmetic_Codec & codec,
+                        Context_Model & literals,
+                        unsigned char block[],
+                        unsigned block_bytes)
+{
+  unsigned p = 0, tokens = 0;
+  while (p < block_bytes) {
+    if (codec.decode(match_flag[tokens])) {
+      unsigned r = unsigned(codec.decode(distance, tokens & 1));
+      unsigned repeat = (r < LZ__RecentDistances), match_distance = r;
+      if (repeat)
+        match_distance = recent[r];
+      else
+        match_distance -= LZ__RecentDistances - 1;
+      unsigned match_length = unsigned(codec.decode(length, repeat));
+      if ((match_distance == 0) || (match_distance > p) ||
+          (match_length > block_bytes - p) ||
+          (block_bytes - p - match_length < LZ__MinMatch))
+        LZ_Error("invalid compressed data");
+      match_length += LZ__MinMatch;
+      use_distance(r, match_distance);
+      tokens = ((tokens << 1) | 1) & 3;
+      const unsigned char * c = block + p - match_distance;     // may overlap
+      for (unsigned n = 0; n < match_length; n++) block[p+n] = c[n];
+      p += match_length;
+    }
+    else {
+      unsigned history = LZ_Previous_Bytes(block, p);
+      block[p] = (unsigned char) codec.decode(literals[history]);
+      tokens = (tokens << 1) & 3;
+      p++;
+    }
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void LZ77_Codec::start_search(const unsigned char * block_data,
+                              unsigned block_bytes)
+{
+  if (head == 0) {                               // hash table size set by the
+    unsigned hash_bits = 12;             // first block, so it fits the blocks
+    while ((hash_bits < LZ__MaxHashBits) && ((4U << hash_bits) < block_bytes))
+      hash_bits++;
+    hash_shift = 32 - hash_bits;
+    head = new unsigned[1U<<hash_bits];
+    if (head == 0) LZ_Error("cannot assign hash table memory");
+    memset(head, 0, sizeof(unsigned) << hash_bits);
+  }
+  if (chain_size < block_bytes) {
+    delete [] chain;
+    chain = new unsigned[chain_size = block_bytes];
+    if (chain == 0) LZ_Error("cannot assign hash chain memory");
+  }
+                         // moving base makes all older positions out of range
+  base += bytes;                          // and hash table is cleared only if
+  if (base > 0xFFFFFFFFU - block_bytes) {              // position values wrap
+    memset(head, 0, sizeof(unsigned) << (32 - hash_shift));
+    base = 1;
+  }
+  data  = block_data;
+  bytes = block_bytes;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void LZ77_Codec::insert(unsigned position)
+{
+  if (position + LZ__MinMatch > bytes) return;
+  unsigned h = LZ_Hash(data + position, hash_shift);
+  chain[position] = head[h];
+  head[h] = base + position;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+unsigned LZ77_Codec::find_match(unsigned position,
+                                unsigned & match_distance)
+{
+  unsigned limit = bytes - position, best = 0;
+  if (limit < LZ__MinMatch) return 0;
+  const unsigned char * b = data + position;
+                                   // recent distances first: cheapest to code
+  for (unsigned r = 0; (r < LZ__RecentDistances) && recent[r]; r++) {
+    if (recent[r] > position) continue;
+    const unsigned char * c = b - recent[r];
+    unsigned n = 0;
+    while ((n < limit) && (c[n] == b[n])) n++;
+    if ((n >= LZ__MinMatch) && (n > best)) {
+      best = n;
+      match_distance = recent[r];
+      if ((best >= LZ__NiceMatch) || (best == limit)) return best;
+    }
+  }
+                            // hash chain has newest (closest) positions first
+  unsigned steps = LZ__ChainSteps, v = head[LZ_Hash(b, hash_shift)];
+  for (; (v >= base) && steps; steps--) {
+    const unsigned char * c = data + (v - base);
+    if (c[best] == b[best]) {                  // only longer matches are used
+      unsigned n = 0;
+      while ((n < limit) && (c[n] == b[n])) n++;
+      if (n > best) {
+        best = n;
+        match_distance = position - (v - base);
+        if ((best >= LZ__NiceMatch) || (best == limit)) break;
+      }
+    }
+    v = chain[v-base];
+  }
+  return (best >= LZ__MinMatch ? best : 0);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+unsigned LZ77_Codec::recent_index(unsigned match_distance)
+{
+  unsigned r = 0;
+  while ((r < LZ__RecentDistances) && (recent[r] != match_distance)) r++;
+  return r;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void LZ77_Codec::use_distance(unsigned index,
+                              unsigned match_distance)
+{                                      // new distance replaces the oldest one
+  if (index >= LZ__RecentDistances) index = LZ__RecentDistances - 1;
+  for (; index; index--) recent[index] = recent[index-1];
+  recent[0] = match_distance;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
@@ -0,0 +1,94 @@
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+//                       ****************************                        -
+//                        ARITHMETIC CODING EXAMPLES                         -
+//                       ****************************                        -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+// LZ77 coding of data blocks with adaptive arithmetic coding                -
+// -> hash-chain match finder, recent distances, and lazy matching           -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+// Version 1.00  -  October 19, 2026                                         -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+//                                  WARNING                                  -
+//                                 =========                                 -
+//                                                                           -
+// The only purpose of this program is to demonstrate the basic principles   -
+// of arithmetic coding. It is provided as is, without any express or        -
+// implied warranty, without even the warranty of fitness for any particular -
+// purpose, or that the implementations are correct.                         -
+//                                                                           -
+// Permission to copy and redistribute this code is hereby granted, provided -
+// that this warning and copyright notices are not removed or altered.       -
+//                                                                           -
+// Copyright (c) 2026 by the FastAC contributors                             -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+
+
+// - - Definitions - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#ifndef LZ77_CODEC
+#define LZ77_CODEC
+
+#include "context_model.h"
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// - - Class definition  - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+   // Codes a block of bytes as literals and matches with earlier bytes of the
+      // same block. Each token starts with a match flag, modeled by the types
+       // of the last two tokens. A match codes the index of one of the 4 most
+        // recent distances, or a new distance, then its length, with adaptive
+// integer models. Literals are coded with the Context_Model of their previous
+    // bytes. The encoder looks for matches in hash chains, and uses a literal
+          // instead when the next byte starts a longer match (lazy matching).
+
+class LZ77_Codec
+{
+public:
+
+  LZ77_Codec(void);
+ ~LZ77_Codec(void);
+
+  void reset(void);                       // each block starts with new models
+
+  void encode(Arithmetic_Codec & codec,        // codec is started, and models
+              Context_Model & literals,           // of literals reset, by the
+              const unsigned char data[],                            // caller
+              unsigned number_of_bytes);
+  void decode(Arithmetic_Codec & codec,
+              Context_Model & literals,
+              unsigned char data[],
+              unsigned number_of_bytes);
+
+private:  //  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .
+  void     start_search(const unsigned char * block_data,
+                        unsigned block_bytes);
+  void     insert(unsigned position);
+  unsigned find_match(unsigned position,              // 0 if shorter than the
+                      unsigned & distance);                   // minimum match
+  unsigned recent_index(unsigned distance);          // 4 if not used recently
+  void     use_distance(unsigned index,                   // moves distance to
+                        unsigned distance);                 // front of recent
+  Adaptive_Bit_Model     match_flag[4];   // context: types of last two tokens
+  Adaptive_Integer_Model distance;        // recent index, or new distance + 3
+  Adaptive_Integer_Model length;
+  unsigned               recent[4];                        // 0 = not used yet
+  const unsigned char * data;
+  unsigned   bytes;
+  unsigned * head, * chain;     // newest position with hash, and the previous
+  unsigned   chain_size, base;    // positions are stored + base: older blocks
+  unsigned   hash_shift;                             // have values below base
+};
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#endif
@@ -0,0 +1,378 @@
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+//                       ****************************                        -
+//                        ARITHMETIC CODING EXAMPLES                         -
+//                       ****************************                        -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+// PPM coding of data blocks with adaptive arithmetic coding                 -
+// -> context trie up to order 8, binary escapes, and exclusions             -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+// Version 1.00  -  October 19, 2026                                         -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+//                                  WARNING                                  -
+//                                 =========                                 -
+//                                                                           -
+// The only purpose of this program is to demonstrate the basic principles   -
+// of arithmetic coding. It is provided as is, without any express or        -
+// implied warranty, without even the warranty of fitness for any particular -
+// purpose, or that the implementations are correct.                         -
+//                                                                           -
+// Permission to copy and redistribute this code is hereby granted, provided -
+// that this warning and copyright notices are not removed or altered.       -
+//                                                                           -
+// Copyright (c) 2026 by the FastAC contributors                             -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+
+// - - Inclusion - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "ppm_codec.h"
+
+
+// - - Constants - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+const unsigned PPM__MaxOrder  = 8;                // longest context, in bytes
+const unsigned PPM__MaxBits   = 10;               // trie memory up to 2^10 MB
+const unsigned PPM__MaxCount  = 240;      // counts halved above: total < 2^16
+const unsigned PPM__Increment = 4;         // count added when symbol is coded
+const unsigned PPM__NewCount  = 3;      // new symbol: 3 + 16 x probability in
+                                                 // context where it was found
+const unsigned PPM__EscapeContexts = 96 * (PPM__MaxOrder + 1);     // in class
+const unsigned PPM__SizeClasses = 9;         // arrays of 1, 2, ... 256 states
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// - - Static functions  - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+static void PPM_Error(const char * msg)
+{
+  fprintf(stderr, "\n\n -> PPM coding error: ");
+  fputs(msg, stderr);
+  fputs("\n Execution terminated!\n", stderr);
+  exit(1);
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// - - PPM codec implementation  - - - - - - - - - - - - - - - - - - - - - - -
+
+PPM_Codec::PPM_Codec(unsigned _max_order,
+                     unsigned memory_bits)
+{
+  if ((_max_order < 1) || (_max_order > PPM__MaxOrder) ||
+      (memory_bits < 1) || (memory_bits > PPM__MaxBits))
+    PPM_Error("invalid context order or memory size");
+  max_order = _max_order;
+  units = unsigned((size_t(1) << (memory_bits + 20)) / sizeof(PPM_Unit));
+  unit = new PPM_Unit[units];
+  if (unit == 0) PPM_Error("cannot assign trie memory");
+  for (unsigned n = 0; n < 256; n++) excluded[n] = 0;
+  stamp = 0;
+  reset();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+PPM_Codec::~PPM_Codec(void)
+{
+  delete [] unit;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void PPM_Codec::reset(void)
+{                           // trie memory is reused without clearing it first
+  PPM_Context & root = context(1);
+  root.states = root.suffix = 0;
+  root.total = root.symbols = 0;
+  for (unsigned k = 0; k < PPM__SizeClasses; k++) free_arrays[k] = 0;
+  for (unsigned e = 0; e < PPM__EscapeContexts; e++) escape[e].reset();
+  used = 3;
+  current = 1;
+  order = 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void PPM_Codec::encode(Arithmetic_Codec & codec,
+                       const unsigned char data[],
+                       unsigned number_of_bytes)
+{
+  for (unsigned p = 0; p < number_of_bytes; p++) encode_byte(codec, data[p]);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void PPM_Codec::decode(Arithmetic_Codec & codec,
+                       unsigned char data[],
+                       unsigned number_of_bytes)
+{
+  for (unsigned p = 0; p < number_of_bytes; p++) data[p] = decode_byte(codec);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+unsigned PPM_Codec::escape_context(unsigned depth,
+                                   unsigned symbols,
+                                   unsigned total)
+{                // escape is a binary decision, with model chosen by order of
+                  // context, exclusions, number of symbols, and average count
+  unsigned s = (symbols <= 3 ? symbols - 1 : symbols <= 5 ? 3 :
+                symbols <= 9 ? 4 : symbols <= 17 ? 5 : symbols <= 64 ? 6 : 7);
+  unsigned a = 0, average = total / symbols;
+  while ((a < 5) && (average >> (a + 1))) a++;
+  return ((order - depth) * 2 + (depth > 0)) * 48 + s * 6 + a;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void PPM_Codec::encode_byte(Arithmetic_Codec & codec,
+                            unsigned char symbol)
+{
+  if (++stamp == 0) {                           // rare wrap: clear exclusions
+    for (unsigned n = 0; n < 256; n++) excluded[n] = 0;
+    stamp = 1;
+  }
+                         // escape from contexts without the symbol, excluding
+  unsigned depth = 0, state = 0;        // their symbols from shorter contexts
+  for (unsigned c = current; c; c = context(c).suffix, depth++) {
+    PPM_Context & x = context(c);
+    PPM_State * st = &unit[x.states].state;
+    unsigned k, found = x.symbols, low = 0, total = 0, symbols = 0;
+    path[depth] = c;
+    if (depth == 0) {                   // no exclusions yet: totals are known
+      total = x.total;
+      symbols = x.symbols;
+      for (k = 0; (k < x.symbols) && (st[k].symbol != symbol); k++) {
+        low += st[k].count;
+        excluded[st[k].symbol] = stamp;
+      }
+      found = k;
+    }
+    else
+      for (k = 0; k < x.symbols; k++) {
+        if (excluded[st[k].symbol] == stamp) continue;
+        excluded[st[k].symbol] = stamp;
+        if (st[k].symbol == symbol) {
+          found = k;
+          low = total;
+        }
+        total += st[k].count;
+        ++symbols;
+      }
+    if (symbols == 0) continue;             // nothing left to code: no escape
+    Adaptive_Bit_Model & e = escape[escape_context(depth, symbols, total)];
+    if (found < x.symbols) {
+      codec.encode(0, e);
+      if (symbols > 1) codec.encode_interval(low, st[found].count, total);
+      state = x.states + found;
+      break;
+    }
+    codec.encode(1, e);
+  }
+
+  if (state == 0) {                    // new symbol: byte values not excluded
+    unsigned low = 0, total = 0;                  // have the same probability
+    for (unsigned n = 0; n < 256; n++)
+      if (excluded[n] != stamp) {
+        if (n < symbol) ++low;
+        ++total;
+      }
+    codec.encode_interval(low, 1, total);
+  }
+
+  update(symbol, depth, state);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+unsigned char PPM_Codec::decode_byte(Arithmetic_Codec & codec)
+{
+  if (++stamp == 0) {
+    for (unsigned n = 0; n < 256; n++) excluded[n] = 0;
+    stamp = 1;
+  }
+
+  unsigned depth = 0, state = 0;
+  for (unsigned c = current; c; c = context(c).suffix, depth++) {
+    PPM_Context & x = context(c);
+    PPM_State * st = &unit[x.states].state;
+    unsigned k, total = 0, symbols = 0;
+    path[depth] = c;
+    if (depth == 0) {
+      total = x.total;
+      symbols = x.symbols;
+    }
+    else
+      for (k = 0; k < x.symbols; k++)
+        if (excluded[st[k].symbol] != stamp) {
+          total += st[k].count;
+          ++symbols;
+        }
+    if (symbols == 0) continue;
+    if (codec.decode(escape[escape_context(depth, symbols, total)]) == 0) {
+      unsigned target = (symbols > 1 ? codec.decode_count(total) : 0);
+      unsigned low = 0;                   // counts of states add up to total,
+      for (k = 0; ; k++) {                                  // so one is found
+        if (excluded[st[k].symbol] == stamp) continue;
+        if (low + st[k].count > target) break;
+        low += st[k].count;
+      }
+      if (symbols > 1) codec.decode_interval(low, st[k].count);
+      state = x.states + k;
+      break;
+    }
+    for (k = 0; k < x.symbols; k++) excluded[st[k].symbol] = stamp;
+  }
+
+  unsigned symbol;
+  if (state)
+    symbol = unit[state].state.symbol;
+  else {
+    unsigned total = 0;
+    for (unsigned n = 0; n < 256; n++)
+      if (excluded[n] != stamp) ++total;
+    if (total == 0) PPM_Error("invalid compressed data");
+    unsigned target = codec.decode_count(total), low = target;
+    for (symbol = 0; (excluded[symbol] == stamp) || target--; symbol++);
+    codec.decode_interval(low, 1);
+  }
+
+  update(symbol, depth, state);
+  return (unsigned char) symbol;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+unsigned PPM_Codec::allocate(unsigned size_class)
+{                              // arrays of 2^size_class units: reused, or new
+  unsigned a = free_arrays[size_class];
+  if (a)
+    free_arrays[size_class] = unit[a].next;
+  else {
+    a = used;
+    used += 1U << size_class;
+  }
+  return a;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+unsigned PPM_Codec::add_state(PPM_Context & x,
+                              unsigned symbol,
+                              unsigned count)
+{
+  unsigned n = x.symbols;
+  if ((n & (n - 1)) == 0) {           // array is full: 0, 1, 2, 4, ... states
+    unsigned k = 0;
+    while ((1U << k) <= n) k++;
+    unsigned a = allocate(k);
+    for (unsigned i = 0; i < n; i++) unit[a+i] = unit[x.states+i];
+    if (n) {                                            // old array is reused
+      unit[x.states].next = free_arrays[k-1];
+      free_arrays[k-1] = x.states;
+    }
+    x.states = a;
+  }
+  PPM_State & st = unit[x.states+n].state;
+  st.successor = 0;
+  st.count = (unsigned short) count;
+  st.symbol = (unsigned char) symbol;
+  x.symbols = (unsigned short) (n + 1);
+  x.total = (unsigned short) (x.total + count);
+  return x.states + n;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+unsigned PPM_Codec::find(unsigned c,
+                         unsigned symbol)
+{
+  PPM_Context & x = context(c);
+  for (unsigned k = 0; k < x.symbols; k++)
+    if (unit[x.states+k].state.symbol == symbol) return x.states + k;
+  return 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+unsigned PPM_Codec::successor(unsigned c,
+                              unsigned depth,
+                              unsigned symbol)
+{                // context extended by symbol, created when first needed; the
+                 // symbol is in all shorter contexts if it is in this context
+  unsigned s = (depth < known_states ? known[depth] : find(c, symbol));
+  if (unit[s].state.successor == 0) {
+    unsigned n = used, suffix = context(c).suffix;
+    used += 2;
+    PPM_Context & x = context(n);
+    x.states = 0;
+    x.total = x.symbols = 0;
+    x.suffix = (suffix ? successor(suffix, depth + 1, symbol) : 1);
+    unit[s].state.successor = n;
+  }
+  return unit[s].state.successor;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void PPM_Codec::rescale(PPM_Context & x)
+{
+  PPM_State * st = &unit[x.states].state;
+  x.total = 0;                                     // halve counts, at least 1
+  for (unsigned k = 0; k < x.symbols; k++)
+    x.total += (st[k].count = (unsigned short) ((st[k].count + 1) >> 1));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void PPM_Codec::update(unsigned symbol,
+                       unsigned depth,
+                       unsigned state)
+{                    // restart when the trie might not grow enough for symbol
+  if (units - used < (max_order + 1) * (256 + 2)) {
+    reset();
+    return;
+  }
+                        // escaped contexts get the symbol, with a first count
+  unsigned count = PPM__NewCount;          // from its probability where found
+  if (state)
+    count += 16 * unit[state].state.count / context(path[depth]).total;
+  for (unsigned d = 0; d < depth; d++)           // (update exclusion: shorter
+    known[d] = add_state(context(path[d]), symbol, count);     // contexts are
+  known_states = depth;                                          // unchanged)
+
+  if (state) {                     // context with the symbol: increase count,
+    PPM_Context & x = context(path[depth]);         // and move state ahead of
+    PPM_State * st = &unit[state].state;               // one with lower count
+    st->count += PPM__Increment;
+    x.total   += PPM__Increment;
+    if ((state > x.states) && (st->count > st[-1].count)) {
+      PPM_State t = st[-1];
+      st[-1] = *st;
+      *st = t;
+      --state;
+    }
+    known[depth] = state;
+    known_states = depth + 1;
+    if (unit[state].state.count > PPM__MaxCount) rescale(x);
+  }
+                              // longest context of next symbol, up to maximum
+  if (order < max_order) {
+    current = successor(path[0], 0, symbol);
+    ++order;
+  }
+  else
+    current = successor(context(path[0]).suffix, 1, symbol);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
@@ -0,0 +1,125 @@
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+//                       ****************************                        -
+//                        ARITHMETIC CODING EXAMPLES                         -
+//                       ****************************                        -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+// PPM coding of data blocks with adaptive arithmetic coding                 -
+// -> context trie up to order 8, binary escapes, and exclusions             -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+// Version 1.00  -  October 19, 2026                                         -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+//                                  WARNING                                  -
+//                                 =========                                 -
+//                                                                           -
+// The only purpose of this program is to demonstrate the basic principles   -
+// of arithmetic coding. It is provided as is, without any express or        -
+// implied warranty, without even the warranty of fitness for any particular -
+// purpose, or that the implementations are correct.                         -
+//                                                                           -
+// Permission to copy and redistribute this code is hereby granted, provided -
+// that this warning and copyright notices are not removed or altered.       -
+//                                                                           -
+// Copyright (c) 2026 by the FastAC contributors                             -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+
+// - - Definitions - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#ifndef PPM_CODEC
+#define PPM_CODEC
+
+#include "arithmetic_codec.h"
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// - - Data structures - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+struct PPM_State                         // symbol in a context, and its count
+{
+  unsigned       successor;         // context extended by symbol, 0 = not yet
+  unsigned short count;
+  unsigned char  symbol, unused;
+};
+
+struct PPM_Context                  // node of the PPM trie: 2 units of memory
+{
+  unsigned       states;           // array of states, 2^n units for up to 2^n
+  unsigned       suffix;          // states; context without oldest byte, 0 if
+  unsigned short total, symbols;                        // root; sum of counts
+};
+
+union PPM_Unit                          // trie memory is allocated in 8 bytes
+{
+  PPM_State state;
+  unsigned  next;                             // next array of same size, free
+};
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// - - Class definition  - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+   // Codes a block of bytes with prediction by partial matching: each byte is
+       // coded in the longest context where it was seen, from 1 to 8 previous
+     // bytes, after binary escapes from the longer contexts without it. Their
+       // symbols are excluded from shorter contexts, and a byte never seen is
+     // coded with equal probabilities. The trie of contexts grows in a memory
+                 // block of 2^bits MB, and is restarted when it becomes full.
+
+class PPM_Codec
+{
+public:
+
+  PPM_Codec(unsigned max_order,                // longest context, 1 to 8, and
+            unsigned memory_bits);          // trie memory: 2^bits MB, to 1 GB
+ ~PPM_Codec(void);
+
+  void reset(void);                   // restart from an empty order-0 context
+
+  void encode(Arithmetic_Codec & codec,            // codec started by caller;
+              const unsigned char data[],      // each block should start with
+              unsigned number_of_bytes);                            // reset()
+  void decode(Arithmetic_Codec & codec,
+              unsigned char data[],
+              unsigned number_of_bytes);
+
+private:  //  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .
+  PPM_Context & context(unsigned c) { return *(PPM_Context *) (unit + c); }
+  void          encode_byte(Arithmetic_Codec & codec,
+                            unsigned char symbol);
+  unsigned char decode_byte(Arithmetic_Codec & codec);
+  unsigned allocate(unsigned size_class);
+  unsigned add_state(PPM_Context & context,
+                     unsigned symbol,
+                     unsigned count);
+  unsigned escape_context(unsigned depth,
+                          unsigned symbols,
+                          unsigned total);
+  unsigned find(unsigned context,
+                unsigned symbol);
+  unsigned successor(unsigned context,
+                     unsigned depth,
+                     unsigned symbol);
+  void     rescale(PPM_Context & context);
+  void     update(unsigned symbol,
+                  unsigned depth,
+                  unsigned state);
+  PPM_Unit * unit;                        // trie: unit 0 is null, 1-2 is root
+  unsigned   units, used, free_arrays[9]; // reusable arrays of 1 to 256 units
+  unsigned   current, order, max_order;      // longest context of next symbol
+  unsigned   path[9];                   // contexts, from the longest, and the
+  unsigned   known[9], known_states;             // symbol's states, order 0-8
+  unsigned   excluded[256], stamp;              // symbols of escaped contexts
+  Adaptive_Bit_Model escape[96*9];          // 96 escape models for each order
+};
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#endif
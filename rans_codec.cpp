@@ -0,0 +1,365 @@
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+//                       ****************************                        -
+//                        ARITHMETIC CODING EXAMPLES                         -
+//                       ****************************                        -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+// Interleaved rANS coding of blocks with static model distributions         -
+// -> 32 states, AVX2 decoder with table gathers, and scalar decoder         -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+// Version 1.00  -  October 19, 2026                                         -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+//                                  WARNING                                  -
+//                                 =========                                 -
+//                                                                           -
+// The only purpose of this program is to demonstrate the basic principles   -
+// of arithmetic coding. It is provided as is, without any express or        -
+// implied warranty, without even the warranty of fitness for any particular -
+// purpose, or that the implementations are correct.                         -
+//                                                                           -
+// Permission to copy and redistribute this code is hereby granted, provided -
+// that this warning and copyright notices are not removed or altered.       -
+//                                                                           -
+// Copyright (c) 2026 by the FastAC contributors                             -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+
+
+// - - Inclusion - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#include <stdlib.h>
+#include <string.h>
+#include "rans_codec.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define RANS_AVX2
+#define RANS_TARGET __attribute__((target("avx2,popcnt")))
+#include <immintrin.h>
+#endif
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1700) &&                               \
+    (defined(_M_X64) || defined(_M_IX86))
+#define RANS_AVX2
+#define RANS_TARGET
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+
+// - - Constants - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+const unsigned RC__Lanes     = 32;                  // interleaved rANS states
+const unsigned RC__ScaleBits = 15;    // slots: model intervals scaled to 2^15
+const unsigned RC__Slots     = 1 << RC__ScaleBits;
+const unsigned RC__Low       = 1 << 16;     // states are in [2^16, 2^32), and
+                                                // are renormalized by 16 bits
+const unsigned RC__Header    = 4 * RC__Lanes;       // final states of encoder
+
+
+// - - Static data - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+static struct RANS_Tables              // filled before main(), so threads can
+{                                                  // decode without any locks
+  RANS_Tables(void);
+  unsigned char refill[256][8];       // AVX2 lane of next word, for each mask
+  bool avx2;
+} RC__Tables;
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// - - Static functions  - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+static void RC_Error(const char * msg)
+{
+  fprintf(stderr, "\n\n -> rANS coding error: ");
+  fputs(msg, stderr);
+  fputs("\n Execution terminated!\n", stderr);
+  exit(1);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+static inline unsigned RC_Word(const unsigned char * p)
+{                                  // little-endian 16-bit word, any alignment
+  return unsigned(p[0]) | (unsigned(p[1]) << 8);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+static void RC_Decode_Scalar(unsigned state[],
+                             const unsigned char * & p,
+                             const unsigned char * end,
+                             const unsigned * slot_info,
+                             const unsigned short * slot_symbol,
+                             unsigned short data[],
+                             unsigned first,
+                             unsigned last)
+{
+  for (unsigned k = first; k < last; k++) {
+    unsigned & x = state[k&(RC__Lanes-1)];
+    unsigned s = x & (RC__Slots - 1), info = slot_info[s];
+    data[k] = slot_symbol[s];                      // symbol from state's slot
+    x = (info & 0xFFFFU) * (x >> RC__ScaleBits) + (info >> 16);
+    if (x < RC__Low) {                            // renormalization: one word
+      if (p + 2 > end) RC_Error("code buffer overflow");
+      x = (x << 16) | RC_Word(p);
+      p += 2;
+    }
+  }
+}
+
+#ifdef RANS_AVX2
+
+RANS_TARGET static unsigned RC_Decode_AVX2(unsigned state[],
+                                           const unsigned char * & p,
+                                           const unsigned char * end,
+                                           const unsigned * slot_info,
+                                           const unsigned short * slot_symbol,
+                                           unsigned short data[],
+                                           unsigned symbols)
+{
+  const __m256i slot_mask = _mm256_set1_epi32(RC__Slots - 1);
+  const __m256i low_mask  = _mm256_set1_epi32(0xFFFF);
+  const __m256i zero      = _mm256_setzero_si256();
+  __m256i x[4], s[4];
+  unsigned v, k;
+
+  for (v = 0; v < 4; v++)
+    x[v] = _mm256_loadu_si256((const __m256i *) (state + 8 * v));
+                                     // whole groups, while 4 x 8 words remain
+  for (k = 0; (k + RC__Lanes <= symbols) && (p + 64 <= end); k += RC__Lanes) {
+    for (v = 0; v < 4; v++) {
+      __m256i slot = _mm256_and_si256(x[v], slot_mask);
+      __m256i info = _mm256_i32gather_epi32((const int *) slot_info, slot, 4);
+      s[v] = _mm256_and_si256(low_mask,
+               _mm256_i32gather_epi32((const int *) slot_symbol, slot, 2));
+      x[v] = _mm256_add_epi32(_mm256_srli_epi32(info, 16),
+               _mm256_mullo_epi32(_mm256_and_si256(info, low_mask),
+                                  _mm256_srli_epi32(x[v], RC__ScaleBits)));
+                             // states below 2^16 take the next words in order
+      __m256i renorm = _mm256_cmpeq_epi32(_mm256_srli_epi32(x[v], 16), zero);
+      unsigned mask = _mm256_movemask_ps(_mm256_castsi256_ps(renorm));
+      __m256i lane = _mm256_cvtepu8_epi32(
+               _mm_loadl_epi64((const __m128i *) RC__Tables.refill[mask]));
+      __m256i word = _mm256_cvtepu16_epi32(
+               _mm_loadu_si128((const __m128i *) p));
+      word = _mm256_permutevar8x32_epi32(word, lane);
+      x[v] = _mm256_blendv_epi8(x[v],
+               _mm256_or_si256(_mm256_slli_epi32(x[v], 16), word), renorm);
+      p += 2 * _mm_popcnt_u32(mask);
+    }
+                                          // symbols are below 2^11: pack them
+    __m256i d0 = _mm256_packus_epi32(s[0], s[1]);
+    __m256i d1 = _mm256_packus_epi32(s[2], s[3]);
+    d0 = _mm256_permute4x64_epi64(d0, 0xD8);         // 128-bit lanes in order
+    d1 = _mm256_permute4x64_epi64(d1, 0xD8);
+    _mm256_storeu_si256((__m256i *) (data + k), d0);
+    _mm256_storeu_si256((__m256i *) (data + k + 16), d1);
+  }
+
+  for (v = 0; v < 4; v++)
+    _mm256_storeu_si256((__m256i *) (state + 8 * v), x[v]);
+
+  return k;                                          // number of symbols done
+}
+
+static bool CPU_Has_AVX2(void)
+{
+#if defined(__GNUC__)
+  __builtin_cpu_init();                  // required when used by constructors
+  return (__builtin_cpu_supports("avx2") != 0) &&
+         (__builtin_cpu_supports("popcnt") != 0);
+#else
+  int info[4];
+  __cpuid(info, 0);
+  if (info[0] < 7) return false;
+  __cpuid(info, 1);                          // OS must save the AVX registers
+  if ((info[2] & 0x18000000) != 0x18000000) return false;
+  if ((_xgetbv(0) & 6) != 6) return false;
+  __cpuidex(info, 7, 0);
+  return (info[1] & (1 << 5)) != 0;
+#endif
+}
+
+#endif
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// - - Implementations - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+RANS_Tables::RANS_Tables(void)
+{
+  for (unsigned mask = 0; mask < 256; mask++) {      // lanes that renormalize
+    unsigned next = 0;                                  // take words in order
+    for (unsigned n = 0; n < 8; n++)
+      refill[mask][n] = (unsigned char) (mask & (1U << n) ? next++ : 0);
+  }
+
+  avx2 = false;                                      // choose version for CPU
+#ifdef RANS_AVX2
+  avx2 = CPU_Has_AVX2();
+#endif
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+bool RANS_AVX2_Decoder(void)
+{
+  return RC__Tables.avx2;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+RANS_Codec::RANS_Codec(void)
+{
+  buffer_size = data_symbols = 0;
+  new_buffer = code_buffer = 0;
+  slot_info = 0;
+  slot_symbol = symbol_start = symbol_freq = 0;
+}
+
+RANS_Codec::RANS_Codec(unsigned max_code_bytes,
+                       unsigned char * user_buffer)
+{
+  buffer_size = data_symbols = 0;
+  new_buffer = code_buffer = 0;
+  slot_info = 0;
+  slot_symbol = symbol_start = symbol_freq = 0;
+  set_buffer(max_code_bytes, user_buffer);
+}
+
+RANS_Codec::~RANS_Codec(void)
+{
+  delete [] new_buffer;
+  delete [] slot_info;
+  delete [] slot_symbol;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void RANS_Codec::set_buffer(unsigned max_code_bytes,
+                            unsigned char * user_buffer)
+{
+                                                  // test for reasonable sizes
+  if ((max_code_bytes < 2 * RC__Header) || (max_code_bytes > 0x40000000U))
+    RC_Error("invalid codec buffer size");
+
+  if (user_buffer != 0) {                       // user provides memory buffer
+    buffer_size = max_code_bytes;
+    code_buffer = user_buffer;               // set buffer for compressed data
+    delete [] new_buffer;                 // free anything previously assigned
+    new_buffer = 0;
+    return;
+  }
+
+  if ((new_buffer != 0) && (max_code_bytes <= buffer_size)) return;
+
+  buffer_size = max_code_bytes;                           // assign new memory
+  delete [] new_buffer;                   // free anything previously assigned
+  if ((new_buffer = new unsigned char[buffer_size]) == 0)
+    RC_Error("cannot assign memory for compressed data buffer");
+  code_buffer = new_buffer;                  // set buffer for compressed data
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void RANS_Codec::set_model(const Static_Data_Model & M)
+{
+  if (M.data_symbols == 0) RC_Error("static model not set");
+
+  if (slot_info == 0) {                    // tables for the largest alphabet,
+    slot_info   = new unsigned[RC__Slots];                     // 2^11 symbols
+    slot_symbol = new unsigned short[RC__Slots+1+2*(1<<11)];
+    if ((slot_info == 0) || (slot_symbol == 0))
+      RC_Error("cannot assign rANS table memory");
+    symbol_start = slot_symbol + RC__Slots + 1;      // 1 word read by gathers
+    symbol_freq  = symbol_start + (1 << 11);
+  }
+                  // arithmetic coding intervals, from model precision to 2^15
+  data_symbols = M.data_symbols;
+  slot_symbol[RC__Slots] = 0;
+  unsigned shift = M.length_shift + 1;
+  for (unsigned s = 0; s < data_symbols; s++) {
+    unsigned start = (M.distribution[s] << 16) >> shift;
+    unsigned end = (s == M.last_symbol ? RC__Slots :
+                    (M.distribution[s+1] << 16) >> shift);
+    if (end <= start) RC_Error("invalid static model distribution");
+    symbol_start[s] = (unsigned short) start;
+    symbol_freq[s]  = (unsigned short) (end - start);
+    for (unsigned n = start; n < end; n++) {
+      slot_info[n]   = (end - start) | ((n - start) << 16);
+      slot_symbol[n] = (unsigned short) s;
+    }
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+unsigned RANS_Codec::encode(const unsigned short data[],
+                            unsigned symbols)
+{
+  if (data_symbols == 0) RC_Error("model not set");
+  if (buffer_size == 0) RC_Error("no code buffer set");
+
+  unsigned k, n, state[RC__Lanes];
+  for (n = 0; n < RC__Lanes; n++) state[n] = RC__Low;
+                           // code backwards, writing words from end of buffer
+  unsigned char * p = code_buffer + buffer_size;
+  for (k = symbols; k-- > 0; ) {
+    unsigned s = data[k];
+#ifdef _DEBUG
+    if (s >= data_symbols) RC_Error("invalid data symbol");
+#endif
+    unsigned & x = state[k&(RC__Lanes-1)], f = symbol_freq[s];
+    if (x >= (f << (32 - RC__ScaleBits))) {         // renormalization: 1 word
+      if (p < code_buffer + RC__Header + 2) RC_Error("code buffer overflow");
+      *--p = (unsigned char) (x >> 8);
+      *--p = (unsigned char) x;
+      x >>= 16;
+    }
+    x = ((x / f) << RC__ScaleBits) + (x % f) + symbol_start[s];
+  }
+                                    // final states, read first by the decoder
+  for (n = RC__Lanes; n-- > 0; ) {
+    p -= 4;
+    p[0] = (unsigned char) state[n];
+    p[1] = (unsigned char) (state[n] >> 8);
+    p[2] = (unsigned char) (state[n] >> 16);
+    p[3] = (unsigned char) (state[n] >> 24);
+  }
+                                       // move code to the start of the buffer
+  unsigned code_bytes = unsigned(code_buffer + buffer_size - p);
+  memmove(code_buffer, p, code_bytes);
+
+  return code_bytes;                                   // number of bytes used
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void RANS_Codec::decode(unsigned short data[],
+                        unsigned symbols)
+{
+  if (data_symbols == 0) RC_Error("model not set");
+  if (buffer_size == 0) RC_Error("no code buffer set");
+
+  unsigned k = 0, state[RC__Lanes];
+  const unsigned char * p = code_buffer, * end = code_buffer + buffer_size;
+  for (unsigned n = 0; n < RC__Lanes; n++, p += 4)
+    state[n] = RC_Word(p) | (RC_Word(p + 2) << 16);
+
+#ifdef RANS_AVX2
+  if (RC__Tables.avx2)                        // full groups, 8 states at once
+    k = RC_Decode_AVX2(state, p, end, slot_info, slot_symbol, data, symbols);
+#endif
+                                          // remaining symbols, or all symbols
+  RC_Decode_Scalar(state, p, end, slot_info, slot_symbol, data, k, symbols);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
@@ -0,0 +1,91 @@
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+//                       ****************************                        -
+//                        ARITHMETIC CODING EXAMPLES                         -
+//                       ****************************                        -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+// Interleaved rANS coding of blocks with static model distributions         -
+// -> 32 states, AVX2 decoder with table gathers, and scalar decoder         -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+// Version 1.00  -  October 19, 2026                                         -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+//                                  WARNING                                  -
+//                                 =========                                 -
+//                                                                           -
+// The only purpose of this program is to demonstrate the basic principles   -
+// of arithmetic coding. It is provided as is, without any express or        -
+// implied warranty, without even the warranty of fitness for any particular -
+// purpose, or that the implementations are correct.                         -
+//                                                                           -
+// Permission to copy and redistribute this code is hereby granted, provided -
+// that this warning and copyright notices are not removed or altered.       -
+//                                                                           -
+// Copyright (c) 2026 by the FastAC contributors                             -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+
+
+// - - Definitions - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#ifndef RANS_CODEC
+#define RANS_CODEC
+
+#include "arithmetic_codec.h"
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// - - Class definition  - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+// Codes whole blocks of symbols with rANS (range asymmetric numeral systems),
+    // using the cumulative distribution of a Static_Data_Model. Symbol k of a
+      // block is coded by state k % 32. The 32 states are independent, so the
+     // decoder can update 8 states per AVX2 instruction, with the symbols and
+  // frequencies gathered from tables indexed by the state's low 15 bits. CPUs
+    // without AVX2 decode the same data with a scalar decoder. The encoder is
+                                     // scalar, and codes the block backwards.
+
+class RANS_Codec
+{
+public:
+
+  RANS_Codec(void);
+ ~RANS_Codec(void);
+  RANS_Codec(unsigned max_code_bytes,
+             unsigned char * user_buffer = 0);               // 0 = assign new
+
+  unsigned char * buffer(void) { return code_buffer; }
+
+  void set_buffer(unsigned max_code_bytes,
+                  unsigned char * user_buffer = 0);          // 0 = assign new
+
+  void set_model(const Static_Data_Model &);    // must be set again after the
+                                               // model's distribution changes
+  unsigned encode(const unsigned short data[],      // returns number of bytes
+                  unsigned number_of_symbols);             // used in buffer()
+  void     decode(unsigned short data[],
+                  unsigned number_of_symbols);
+
+private:  //  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .
+  unsigned char * code_buffer, * new_buffer;
+  unsigned * slot_info;              // per slot: frequency, offset from start
+  unsigned short * slot_symbol, * symbol_start, * symbol_freq;
+  unsigned buffer_size, data_symbols;
+};
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// - - Prototypes  - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+bool RANS_AVX2_Decoder(void);            // true if decoding with AVX2 gathers
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#endif
@@ -0,0 +1,252 @@
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+//                       ****************************                        -
+//                        ARITHMETIC CODING EXAMPLES                         -
+//                       ****************************                        -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+// Split-stream container: one payload coded as several substreams           -
+// -> one Arithmetic_Codec per substream, for parallel decoding              -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+// Version 1.00  -  October 19, 2026                                         -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+//                                  WARNING                                  -
+//                                 =========                                 -
+//                                                                           -
+// The only purpose of this program is to demonstrate the basic principles   -
+// of arithmetic coding. It is provided as is, without any express or        -
+// implied warranty, without even the warranty of fitness for any particular -
+// purpose, or that the implementations are correct.                         -
+//                                                                           -
+// Permission to copy and redistribute this code is hereby granted, provided -
+// that this warning and copyright notices are not removed or altered.       -
+//                                                                           -
+// Copyright (c) 2026 by the FastAC contributors                             -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+
+
+// - - Inclusion - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#include <stdlib.h>
+#include <string.h>
+#include "split_stream_codec.h"
+
+
+// - - Constants - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+const unsigned SS__MaxStreams = 256;            // substreams in one container
+const unsigned SS__MaxBytes   = 0x1000000U;   // Arithmetic_Codec buffer limit
+const unsigned SS__SizeBytes  = 4;            // maximum bytes of a coded size
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// - - Static functions  - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+static void SS_Error(const char * msg)
+{
+  fprintf(stderr, "\n\n -> Split-stream coding error: ");
+  fputs(msg, stderr);
+  fputs("\n Execution terminated!\n", stderr);
+  exit(1);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+static unsigned char * SS_Put_Size(unsigned char * p, unsigned n)
+{
+  do {                               // 7 bits per byte, high bit = more bytes
+    *p = (unsigned char)(n & 0x7FU);
+    if ((n >>= 7) > 0) *p |= 0x80U;
+    ++p;
+  } while (n);
+  return p;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+static const unsigned char * SS_Get_Size(const unsigned char * p,
+                                         const unsigned char * end,
+                                         unsigned & n)
+{
+  unsigned shift = 0;
+  n = 0;
+  do {
+    if ((p == end) || (shift >= 7 * SS__SizeBytes))
+      SS_Error("invalid container header");
+    n |= unsigned(*p & 0x7FU) << shift;
+    shift += 7;
+  } while (*p++ & 0x80U);
+  return p;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+static unsigned SS_Read_Size(FILE * code_file)
+{
+  unsigned n = 0, shift = 0;
+  int file_byte;
+  do {
+    if ((file_byte = getc(code_file)) == EOF)
+      SS_Error("cannot read code from file");
+    if (shift >= 7 * SS__SizeBytes) SS_Error("invalid container header");
+    n |= unsigned(file_byte & 0x7F) << shift;
+    shift += 7;
+  } while (file_byte & 0x80);
+  return n;
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// - - Split_Stream_Codec implementation - - - - - - - - - - - - - - - - - - -
+
+Split_Stream_Codec::Split_Stream_Codec(void)
+{
+  codec = 0;
+  container = 0;
+  number_of_streams = max_code_bytes = container_size = 0;
+}
+
+Split_Stream_Codec::Split_Stream_Codec(unsigned streams,
+                                       unsigned max_bytes)
+{
+  codec = 0;
+  container = 0;
+  number_of_streams = max_code_bytes = container_size = 0;
+  set_streams(streams, max_bytes);
+}
+
+Split_Stream_Codec::~Split_Stream_Codec(void)
+{
+  delete [] codec;
+  delete [] container;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void Split_Stream_Codec::set_streams(unsigned streams,
+                                     unsigned max_bytes)
+{
+  if ((streams < 1) || (streams > SS__MaxStreams))
+    SS_Error("invalid number of substreams");
+  if ((max_bytes < 16) || (max_bytes > SS__MaxBytes))
+    SS_Error("invalid substream buffer size");
+
+  if (number_of_streams != streams) {            // codecs are not in use here
+    delete [] codec;
+    codec = new Arithmetic_Codec[number_of_streams = streams];
+    if (codec == 0) SS_Error("cannot assign codec memory");
+    max_code_bytes = 0;
+  }
+  if (max_code_bytes < max_bytes) max_code_bytes = max_bytes;
+  for (unsigned n = 0; n < number_of_streams; n++)
+    codec[n].set_buffer(max_code_bytes);        // only grows existing buffers
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void Split_Stream_Codec::start_encoder(void)
+{
+  if (number_of_streams == 0) SS_Error("no substreams set");
+  for (unsigned n = 0; n < number_of_streams; n++) codec[n].start_encoder();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+unsigned Split_Stream_Codec::stop_encoder(void)
+{
+  unsigned n, size[SS__MaxStreams];
+                                             // header bytes: count, and sizes
+  unsigned bytes = SS__SizeBytes * (number_of_streams + 1);
+  for (n = 0; n < number_of_streams; n++)
+    bytes += (size[n] = codec[n].stop_encoder());
+
+  if (container_size < bytes) {                     // assign container memory
+    delete [] container;
+    container = new unsigned char[container_size = bytes];
+    if (container == 0) SS_Error("cannot assign container memory");
+  }
+                                         // write header, then copy substreams
+  unsigned char * p = SS_Put_Size(container, number_of_streams);
+  for (n = 0; n < number_of_streams; n++) p = SS_Put_Size(p, size[n]);
+  for (n = 0; n < number_of_streams; n++) {
+    memcpy(p, codec[n].buffer(), size[n]);
+    p += size[n];
+  }
+
+  return unsigned(p - container);                       // container size used
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+unsigned Split_Stream_Codec::write_to_file(FILE * code_file)
+{
+  unsigned bytes = stop_encoder();
+
+  if (fwrite(container, 1, bytes, code_file) != bytes)
+    SS_Error("cannot write compressed data to file");
+
+  return bytes;                                                  // bytes used
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void Split_Stream_Codec::start_decoder(const unsigned char * data,
+                                       unsigned bytes)
+{
+  const unsigned char * end = data + bytes;
+  unsigned n, streams, largest = 16, size[SS__MaxStreams];
+                                       // read header: substreams, their sizes
+  data = SS_Get_Size(data, end, streams);
+  if ((streams < 1) || (streams > SS__MaxStreams))
+    SS_Error("invalid container header");
+  for (n = 0; n < streams; n++) {
+    data = SS_Get_Size(data, end, size[n]);
+    if (size[n] > largest) largest = size[n];
+  }
+                                 // decoders follow the container's substreams
+  set_streams(streams, largest);
+                                            // copy substreams, start decoders
+  for (n = 0; n < streams; n++) {
+    if (size[n] > unsigned(end - data)) SS_Error("incomplete container");
+    memcpy(codec[n].buffer(), data, size[n]);
+    data += size[n];
+    codec[n].start_decoder();
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void Split_Stream_Codec::read_from_file(FILE * code_file)
+{
+  unsigned n, streams, largest = 16, size[SS__MaxStreams];
+                                       // read header: substreams, their sizes
+  streams = SS_Read_Size(code_file);
+  if ((streams < 1) || (streams > SS__MaxStreams))
+    SS_Error("invalid container header");
+  for (n = 0; n < streams; n++)
+    if ((size[n] = SS_Read_Size(code_file)) > largest) largest = size[n];
+
+  set_streams(streams, largest);
+                                            // read substreams, start decoders
+  for (n = 0; n < streams; n++) {
+    if (fread(codec[n].buffer(), 1, size[n], code_file) != size[n])
+      SS_Error("cannot read code from file");
+    codec[n].start_decoder();
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void Split_Stream_Codec::stop_decoder(void)
+{
+  for (unsigned n = 0; n < number_of_streams; n++) codec[n].stop_decoder();
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
@@ -0,0 +1,93 @@
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+//                       ****************************                        -
+//                        ARITHMETIC CODING EXAMPLES                         -
+//                       ****************************                        -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+// Split-stream container: one payload coded as several substreams           -
+// -> one Arithmetic_Codec per substream, for parallel decoding              -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+// Version 1.00  -  October 19, 2026                                         -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+//                                  WARNING                                  -
+//                                 =========                                 -
+//                                                                           -
+// The only purpose of this program is to demonstrate the basic principles   -
+// of arithmetic coding. It is provided as is, without any express or        -
+// implied warranty, without even the warranty of fitness for any particular -
+// purpose, or that the implementations are correct.                         -
+//                                                                           -
+// Permission to copy and redistribute this code is hereby granted, provided -
+// that this warning and copyright notices are not removed or altered.       -
+//                                                                           -
+// Copyright (c) 2026 by the FastAC contributors                             -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+
+
+// - - Definitions - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#ifndef SPLIT_STREAM_CODEC
+#define SPLIT_STREAM_CODEC
+
+#include "arithmetic_codec.h"
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// - - Class definition  - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+     // One payload coded as several independent substreams, each with its own
+   // Arithmetic_Codec. The encoder decides which substream codes each symbol,
+   // e.g. symbol k goes to stream(k % streams()), and the decoder must follow
+     // the same rule. Substreams can be decoded by different threads, if each
+    // substream has its own adaptive models; static models can be shared. One
+           // thread can also alternate between substreams, which overlaps the
+       // dependency chains of their decoders, and then adaptive models can be
+   // shared too, as long as symbols are decoded in the order they were coded.
+                                                                            //
+    // Container: number of substreams, the size of each one (7 bits per byte,
+     // as in Arithmetic_Codec::write_to_file), and then the substreams' data.
+
+class Split_Stream_Codec
+{
+public:
+
+  Split_Stream_Codec(void);
+ ~Split_Stream_Codec(void);
+  Split_Stream_Codec(unsigned number_of_streams,
+                     unsigned max_code_bytes);                // per substream
+
+  unsigned streams(void) { return number_of_streams; }
+
+  Arithmetic_Codec & stream(unsigned n) { return codec[n]; }
+
+  void set_streams(unsigned number_of_streams,                    // up to 256
+                   unsigned max_code_bytes);     // per substream, up to 16 MB
+
+  void     start_encoder(void);
+  unsigned stop_encoder(void);          // returns container size, in buffer()
+  unsigned write_to_file(FILE * code_file);        // stop encoder, write data
+
+  unsigned char * buffer(void) { return container; }
+
+  void     start_decoder(const unsigned char * data,         // container from
+                         unsigned bytes);              // stop_encoder, copied
+  void     read_from_file(FILE * code_file);      // read data, start decoders
+  void     stop_decoder(void);
+
+private:  //  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .
+  Arithmetic_Codec * codec;
+  unsigned char * container;
+  unsigned number_of_streams, max_code_bytes, container_size;
+};
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#endif
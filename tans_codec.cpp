@@ -0,0 +1,321 @@
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+//                       ****************************                        -
+//                        ARITHMETIC CODING EXAMPLES                         -
+//                       ****************************                        -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+// Tabled ANS (tANS) coding of blocks with static model distributions        -
+// -> state tables built from the model, decoding with lookups and bit reads -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+// Version 1.00  -  October 19, 2026                                         -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+//                                  WARNING                                  -
+//                                 =========                                 -
+//                                                                           -
+// The only purpose of this program is to demonstrate the basic principles   -
+// of arithmetic coding. It is provided as is, without any express or        -
+// implied warranty, without even the warranty of fitness for any particular -
+// purpose, or that the implementations are correct.                         -
+//                                                                           -
+// Permission to copy and redistribute this code is hereby granted, provided -
+// that this warning and copyright notices are not removed or altered.       -
+//                                                                           -
+// Copyright (c) 2026 by the FastAC contributors                             -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+
+
+// - - Inclusion - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#include <stdlib.h>
+#include <string.h>
+#include "tans_codec.h"
+
+
+// - - Constants - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+const unsigned TC__TableBits = 12;                     // 2^12 tANS states, or
+const unsigned TC__LargeBits = 13;                    // 2^13 above 16 symbols
+const unsigned TC__MaxStates = 1 << TC__LargeBits;
+const unsigned TC__MaxSymbols = 1 << 11;
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// - - Static functions  - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+static void TC_Error(const char * msg)
+{
+  fprintf(stderr, "\n\n -> tANS coding error: ");
+  fputs(msg, stderr);
+  fputs("\n Execution terminated!\n", stderr);
+  exit(1);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+static inline unsigned TC_Bit_Length(unsigned a)     // 0 for a = 0, otherwise
+{                                           // 1 + index of most significant 1
+  unsigned n = 0;
+  while (a) { a >>= 1;  ++n; }
+  return n;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+static inline unsigned long long TC_Load(const unsigned char * p,
+                                         const unsigned char * end)
+{                      // big-endian 64-bit word, zeros after the buffer's end
+  unsigned long long w = 0;
+  if (p + 8 <= end) {
+#if defined(__GNUC__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+    memcpy(&w, p, 8);
+    return __builtin_bswap64(w);
+#elif defined(_MSC_VER) && (_MSC_VER >= 1400)
+    memcpy(&w, p, 8);
+    return _byteswap_uint64(w);
+#else
+    for (unsigned k = 0; k < 8; k++) w = (w << 8) | p[k];
+    return w;
+#endif
+  }
+  if (p > end) TC_Error("code buffer overflow");
+  for (unsigned k = 0; k < 8; k++)
+    w = (w << 8) | (p + k < end ? p[k] : 0);
+  return w;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+static inline unsigned TC_Decode(unsigned & state,
+                                 const unsigned * decoder_table,
+                                 unsigned long long bits,
+                                 unsigned & used)
+{                    // table entry: next state base, bits to read, and symbol
+  unsigned e = decoder_table[state], n = (e >> 16) & 0x1FU;
+  state = (e & 0xFFFFU) + unsigned(((bits << used) >> 1) >> (63 - n));
+  used += n;                                          // reads 0 bits if n = 0
+  return e >> 21;
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// - - Implementations - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+TANS_Codec::TANS_Codec(void)
+{
+  buffer_size = data_symbols = table_bits = 0;
+  new_buffer = code_buffer = 0;
+  decoder_table = symbol_bits = 0;
+  symbol_state = 0;
+  state_table = symbol_count = 0;
+}
+
+TANS_Codec::TANS_Codec(unsigned max_code_bytes,
+                       unsigned char * user_buffer)
+{
+  buffer_size = data_symbols = table_bits = 0;
+  new_buffer = code_buffer = 0;
+  decoder_table = symbol_bits = 0;
+  symbol_state = 0;
+  state_table = symbol_count = 0;
+  set_buffer(max_code_bytes, user_buffer);
+}
+
+TANS_Codec::~TANS_Codec(void)
+{
+  delete [] new_buffer;
+  delete [] decoder_table;
+  delete [] symbol_state;
+  delete [] state_table;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void TANS_Codec::set_buffer(unsigned max_code_bytes,
+                            unsigned char * user_buffer)
+{
+                                                  // test for reasonable sizes
+  if ((max_code_bytes < 16) || (max_code_bytes > 0x40000000U))
+    TC_Error("invalid codec buffer size");
+
+  if (user_buffer != 0) {                       // user provides memory buffer
+    buffer_size = max_code_bytes;
+    code_buffer = user_buffer;               // set buffer for compressed data
+    delete [] new_buffer;                 // free anything previously assigned
+    new_buffer = 0;
+    return;
+  }
+
+  if ((new_buffer != 0) && (max_code_bytes <= buffer_size)) return;
+
+  buffer_size = max_code_bytes;                           // assign new memory
+  delete [] new_buffer;                   // free anything previously assigned
+  if ((new_buffer = new unsigned char[buffer_size]) == 0)
+    TC_Error("cannot assign memory for compressed data buffer");
+  code_buffer = new_buffer;                  // set buffer for compressed data
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void TANS_Codec::set_model(const Static_Data_Model & M)
+{
+  if (M.data_symbols == 0) TC_Error("static model not set");
+
+  if (decoder_table == 0) {                 // tables for the largest alphabet
+    decoder_table = new unsigned[TC__MaxStates+TC__MaxSymbols];
+    symbol_state  = new int[TC__MaxSymbols];
+    state_table   = new unsigned short[2*TC__MaxStates+2*TC__MaxSymbols];
+    if ((decoder_table == 0) || (symbol_state == 0) || (state_table == 0))
+      TC_Error("cannot assign tANS table memory");
+    symbol_bits  = decoder_table + TC__MaxStates;
+    symbol_count = state_table + 2 * TC__MaxStates;
+  }
+
+  data_symbols = M.data_symbols;
+  table_bits = (data_symbols > 16 ? TC__LargeBits : TC__TableBits);
+  unsigned s, n, states = 1U << table_bits, total = 0, largest = 0;
+  unsigned bits = M.length_shift;                    // precision of the model
+                          // quantize distribution: every symbol needs a state
+  for (s = 0; s < data_symbols; s++) {
+    unsigned end = (s == M.last_symbol ? 1U << bits : M.distribution[s+1]);
+    n = (((end - M.distribution[s]) << table_bits) + (1U << (bits - 1))) >>
+        bits;
+    symbol_count[s] = (unsigned short) (n ? n : 1);
+    total += symbol_count[s];
+    if (symbol_count[s] > symbol_count[largest]) largest = s;
+  }
+  if ((total > states) &&                       // correct total with largest,
+      (total - states < (symbol_count[largest] >> 1u)))       // or one by one
+    symbol_count[largest] -= (unsigned short) (total - states);
+  else
+    while (total > states) {
+      for (largest = s = 0; s < data_symbols; s++)
+        if (symbol_count[s] > symbol_count[largest]) largest = s;
+      --symbol_count[largest];
+      --total;
+    }
+  if (total < states)
+    symbol_count[largest] += (unsigned short) (states - total);
+
+                       // spread symbols over states, with a step prime to 2^#
+  unsigned short * symbol_next = symbol_count + TC__MaxSymbols;
+  unsigned short * state_symbol = state_table + TC__MaxStates;
+  unsigned step = (states >> 1) + (states >> 3) + 3, pos = 0;
+  for (s = 0, total = 0; s < data_symbols; s++) {
+    symbol_next[s] = (unsigned short) total;            // first encoder state
+    for (n = 0; n < symbol_count[s]; n++) {
+      state_symbol[pos] = (unsigned short) s;
+      pos = (pos + step) & (states - 1);
+    }
+    unsigned c = symbol_count[s];          // encoder: bits sent for the state
+    unsigned max_bits = table_bits + 1 - TC_Bit_Length(c - 1);
+    if (c == 1) max_bits = table_bits;
+    symbol_bits[s]  = (max_bits << 16) - (c << max_bits);
+    symbol_state[s] = int(total) - int(c);
+    total += c;
+  }
+                                      // encoder's next states, in state order
+  for (pos = 0; pos < states; pos++) {
+    s = state_symbol[pos];
+    state_table[symbol_next[s]++] = (unsigned short) (states + pos);
+  }
+                                               // decoder: inverse transitions
+  for (s = 0; s < data_symbols; s++) symbol_next[s] = symbol_count[s];
+  for (pos = 0; pos < states; pos++) {
+    s = state_symbol[pos];
+    unsigned next = symbol_next[s]++;
+    unsigned bits = table_bits + 1 - TC_Bit_Length(next);
+    decoder_table[pos] = ((next << bits) - states) | (bits << 16) | (s << 21);
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+unsigned TANS_Codec::encode(const unsigned short data[],
+                            unsigned symbols)
+{
+  if (data_symbols == 0) TC_Error("model not set");
+  if (buffer_size == 0) TC_Error("no code buffer set");
+
+  unsigned k, states = 1U << table_bits, state[2] = { states, states };
+  unsigned long long bits = 0;                         // bits not written yet
+  unsigned count = 0;
+                           // code backwards, writing bytes from end of buffer
+  unsigned char * p = code_buffer + buffer_size;
+  for (k = symbols; k-- > 0; ) {
+    unsigned s = data[k];
+#ifdef _DEBUG
+    if (s >= data_symbols) TC_Error("invalid data symbol");
+#endif
+    unsigned & x = state[k&1], n = (x + symbol_bits[s]) >> 16;
+    bits |= (unsigned long long) (x & ((1U << n) - 1)) << count;
+    count += n;
+    x = state_table[int(x >> n)+symbol_state[s]];
+    if (count >= 32) {                                        // write 4 bytes
+      if (p < code_buffer + 12) TC_Error("code buffer overflow");
+      for (unsigned b = 0; b < 4; b++, bits >>= 8)
+        *--p = (unsigned char) bits;
+      count -= 32;
+    }
+  }
+                       // final states, read first by the decoder, and a 1 bit
+  bits |= (unsigned long long) (state[1] - states) << count;
+  count += table_bits;
+  bits |= (unsigned long long) (state[0] - states) << count;
+  count += table_bits;
+  bits |= 1ULL << count++;
+  for (; count > 0; count = (count > 8 ? count - 8 : 0), bits >>= 8) {
+    if (p == code_buffer) TC_Error("code buffer overflow");
+    *--p = (unsigned char) bits;
+  }
+                                       // move code to the start of the buffer
+  unsigned code_bytes = unsigned(code_buffer + buffer_size - p);
+  memmove(code_buffer, p, code_bytes);
+
+  return code_bytes;                                   // number of bytes used
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void TANS_Codec::decode(unsigned short data[],
+                        unsigned symbols)
+{
+  if (data_symbols == 0) TC_Error("model not set");
+  if (buffer_size == 0) TC_Error("no code buffer set");
+
+  const unsigned char * p = code_buffer, * end = code_buffer + buffer_size;
+  if (*p == 0) TC_Error("invalid tANS code");
+                                         // skip zeros and 1 bit before states
+  unsigned long long bits = TC_Load(p, end);
+  unsigned used = 9 - TC_Bit_Length(*p), k = 0, mask = (1U << table_bits) - 1;
+  unsigned x0 = unsigned(bits << used >> (64 - table_bits)) & mask;
+  used += table_bits;
+  unsigned x1 = unsigned(bits << used >> (64 - table_bits)) & mask;
+  used += table_bits;
+                            // 4 symbols use at most 52 bits: one load for all
+  for (; k + 4 <= symbols; k += 4) {
+    p += used >> 3;
+    used &= 7;
+    bits = TC_Load(p, end);
+    data[k]   = (unsigned short) TC_Decode(x0, decoder_table, bits, used);
+    data[k+1] = (unsigned short) TC_Decode(x1, decoder_table, bits, used);
+    data[k+2] = (unsigned short) TC_Decode(x0, decoder_table, bits, used);
+    data[k+3] = (unsigned short) TC_Decode(x1, decoder_table, bits, used);
+  }
+  for (; k < symbols; k++) {
+    p += used >> 3;
+    used &= 7;
+    bits = TC_Load(p, end);
+    data[k] = (unsigned short) TC_Decode(k & 1 ? x1 : x0, decoder_table,
+                                         bits, used);
+  }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
@@ -0,0 +1,88 @@
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+//                       ****************************                        -
+//                        ARITHMETIC CODING EXAMPLES                         -
+//                       ****************************                        -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+// Tabled ANS (tANS) coding of blocks with static model distributions        -
+// -> state tables built from the model, decoding with lookups and bit reads -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+// Version 1.00  -  October 19, 2026                                         -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//                                                                           -
+//                                  WARNING                                  -
+//                                 =========                                 -
+//                                                                           -
+// The only purpose of this program is to demonstrate the basic principles   -
+// of arithmetic coding. It is provided as is, without any express or        -
+// implied warranty, without even the warranty of fitness for any particular -
+// purpose, or that the implementations are correct.                         -
+//                                                                           -
+// Permission to copy and redistribute this code is hereby granted, provided -
+// that this warning and copyright notices are not removed or altered.       -
+//                                                                           -
+// Copyright (c) 2026 by the FastAC contributors                             -
+//                                                                           -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+
+
+// - - Definitions - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#ifndef TANS_CODEC
+#define TANS_CODEC
+
+#include "arithmetic_codec.h"
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// - - Class definition  - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+         // Codes whole blocks of symbols with tANS (tabled asymmetric numeral
+           // systems, as in FSE). set_model() quantizes the distribution of a
+      // Static_Data_Model to 2^12 states (2^13 above 16 symbols), spreads the
+   // symbols over the states, and builds the encoder and decoder tables. Each
+    // decoded symbol is one table lookup plus a read of 0 to 13 bits, with no
+      // multiplication or division. Two states alternate, to overlap lookups.
+      // The interface is the same as RANS_Codec's, so each stream can use the
+   // coder that suits it: tANS for small alphabets, rANS for exact intervals.
+
+class TANS_Codec
+{
+public:
+
+  TANS_Codec(void);
+ ~TANS_Codec(void);
+  TANS_Codec(unsigned max_code_bytes,
+             unsigned char * user_buffer = 0);               // 0 = assign new
+
+  unsigned char * buffer(void) { return code_buffer; }
+
+  void set_buffer(unsigned max_code_bytes,
+                  unsigned char * user_buffer = 0);          // 0 = assign new
+
+  void set_model(const Static_Data_Model &);    // must be set again after the
+                                               // model's distribution changes
+  unsigned encode(const unsigned short data[],      // returns number of bytes
+                  unsigned number_of_symbols);             // used in buffer()
+  void     decode(unsigned short data[],
+                  unsigned number_of_symbols);
+
+private:  //  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .
+  unsigned char * code_buffer, * new_buffer;
+  unsigned * decoder_table;         // per state: next state, bits, and symbol
+  unsigned * symbol_bits;         // per symbol: encoder's bit count threshold
+  int * symbol_state;             // per symbol: offset in encoder state table
+  unsigned short * state_table, * symbol_count;
+  unsigned buffer_size, data_symbols, table_bits;
+};
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+#endif
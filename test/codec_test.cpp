@@ -42,14 +42,24 @@
 
 #include <math.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "test_support.h"
 #include "arithmetic_codec.h"
+#include "rans_codec.h"
+#include "tans_codec.h"
+#include "huffman_codec.h"
+#include "split_stream_codec.h"
+#include "bwt_codec.h"
+#include "lz77_codec.h"
+#include "ppm_codec.h"
 
 
 // - - Constants - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
 const unsigned SimulTests = 1000000;
+const unsigned CheckTests = 100000;             // symbols per interface check
+const unsigned MaxBlockBytes = 1U << 22;      // largest acfile block: 4096 KB
 
 
 // - - Definitions - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -58,9 +68,18 @@ struct Test_Result
 {
   unsigned alphabet_symbols;
   double   encoder_time, decoder_time;
+  double   encoder_cycles, decoder_cycles;
   double   entropy, bits_used, test_symbols;
 };
 
+struct Item_Models            // models for checks with a mix of types of data
+{
+  Adaptive_Data_Model    data;
+  Adaptive_Bit_Model     bit;
+  Adaptive_Integer_Model integer;
+  Adaptive_Sparse_Model  sparse;
+};
+
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 // - - Implementations for testing encoder/decoder - - - - - - - - - - - - - -
@@ -159,6 +178,66 @@ void Decode_Data_Buffer(unsigned short data_buffer[],
   decoder.stop_decoder();
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+unsigned Encode_Data_Buffer(unsigned short data_buffer[],
+                            Static_Data_Model & model,
+                            RANS_Codec & encoder)
+{
+  encoder.set_model(model);
+  return 8 * encoder.encode(data_buffer, SimulTests);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void Decode_Data_Buffer(unsigned short data_buffer[],
+                        Static_Data_Model & model,
+                        RANS_Codec & decoder)
+{
+  decoder.set_model(model);
+  decoder.decode(data_buffer, SimulTests);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+unsigned Encode_Data_Buffer(unsigned short data_buffer[],
+                            Static_Data_Model & model,
+                            TANS_Codec & encoder)
+{
+  encoder.set_model(model);
+  return 8 * encoder.encode(data_buffer, SimulTests);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void Decode_Data_Buffer(unsigned short data_buffer[],
+                        Static_Data_Model & model,
+                        TANS_Codec & decoder)
+{
+  decoder.set_model(model);
+  decoder.decode(data_buffer, SimulTests);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+unsigned Encode_Data_Buffer(unsigned short data_buffer[],
+                            Static_Data_Model & model,
+                            Huffman_Codec & encoder)
+{
+  encoder.set_model(model);
+  return 8 * encoder.encode(data_buffer, SimulTests);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void Decode_Data_Buffer(unsigned short data_buffer[],
+                        Static_Data_Model & model,
+                        Huffman_Codec & decoder)
+{
+  decoder.set_model(model);
+  decoder.decode(data_buffer, SimulTests);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
   
 void Fill_Bit_Buffer(Random_Bit_Source & src,
@@ -182,18 +261,30 @@ void Fill_Data_Buffer(Random_Data_Source & src,
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
 void Display_Results(bool first,
-                     bool adaptive,
-                     Test_Result & pr,
+                     int pass,              // 0 = static, 1 = adaptive model,
+                     Test_Result & pr,     // 2 = static model, rANS, 3 = tANS
+                                              // 4 = Huffman, 5 = its fallback
                      double source_time)
 {
-  if (adaptive)
+  if (pass == 1)
     puts(" Test with adaptive model\n");
-  else {
-    if (first)
-      puts("\n==============================================================="
-        "==========");
-    puts(" Test with static model\n");
-  }
+  else
+    if (pass == 2)
+      printf(" Test with static model, interleaved rANS (%s decoder)\n\n",
+        RANS_AVX2_Decoder() ? "AVX2" : "scalar");
+    else
+      if (pass == 3)
+        puts(" Test with static model, tANS\n");
+      else
+        if (pass >= 4)
+          printf(" Test with static model, %s\n\n", pass == 4 ?
+            "canonical Huffman code" : "Huffman codec's arithmetic fallback");
+        else {
+          if (first)
+            puts("\n========================================================="
+              "================");
+          puts(" Test with static model\n");
+        }
 
   printf(" Random  data generated in %5.2f seconds\n", source_time);
   printf(" Encoder test completed in %5.2f seconds\n", pr.encoder_time);
@@ -225,6 +316,13 @@ void Display_Results(bool first,
     1e-6 * pr.test_symbols / pr.decoder_time,
     1e-6 * pr.bits_used / pr.decoder_time);
 
+  if (pr.encoder_cycles > 0) {
+    printf("\n Encoder cycles = %8.3f cycles/symbol = %8.3f cycles/bit\n",
+      pr.encoder_cycles / pr.test_symbols, pr.encoder_cycles / pr.bits_used);
+    printf(" Decoder cycles = %8.3f cycles/symbol = %8.3f cycles/bit\n",
+      pr.decoder_cycles / pr.test_symbols, pr.decoder_cycles / pr.bits_used);
+  }
+
   puts("====================================================================="
     "====");
 }
@@ -241,19 +339,27 @@ void Binary_Benchmark(int num_cycles)
   Test_Result        result;
   Random_Bit_Source  src;
   Arithmetic_Codec   codec(SimulTests >> 2);
+  RANS_Codec         rans_codec(SimulTests >> 2);
+  TANS_Codec         tans_codec(SimulTests >> 2);
   Static_Bit_Model   static_model;
+  Static_Data_Model  static_data_model;
   Adaptive_Bit_Model adaptive_model;
   Chronometer        encoder_time, decoder_time, source_time;
+  Cycle_Counter      encoder_cycles, decoder_cycles;
 
                                          // assign memory for random test data
   unsigned code_bits;
   unsigned char * source_bits  = new unsigned char[2*SimulTests];
   unsigned char * decoded_bits = source_bits + SimulTests;
   if (source_bits == 0) Error("Cannot assign memory for random bit buffer");
+                          // bits as 2-symbol data for the rANS and tANS tests
+  unsigned short * source_data  = new unsigned short[2*SimulTests];
+  unsigned short * decoded_data = source_data + SimulTests;
+  if (source_data == 0) Error("Cannot assign memory for random data buffer");
 
   for (int simul = 0; simul < num_simulations; simul++) {
 
-    for (int pass = 0; pass <= 1; pass++) {
+    for (int pass = 0; pass <= 3; pass++) {
 
       src.set_entropy(entropy);
       src.set_seed(1839304 + 2017 * simul);
@@ -266,6 +372,8 @@ void Binary_Benchmark(int num_cycles)
       source_time.reset();                           // reset all chronometers
       encoder_time.reset();
       decoder_time.reset();
+      encoder_cycles.reset();
+      decoder_cycles.reset();
 
       for (int cycle = 0; cycle < num_cycles; cycle++) {
 
@@ -276,24 +384,64 @@ void Binary_Benchmark(int num_cycles)
         if (pass == 0) {
           static_model.set_probability_0(src.symbol_0_probability());
           encoder_time.start();
+          encoder_cycles.start();
           code_bits = Encode_Bit_Buffer(source_bits, static_model, codec);
+          encoder_cycles.stop();
           encoder_time.stop();
 
           decoder_time.start();
+          decoder_cycles.start();
           Decode_Bit_Buffer(decoded_bits, static_model, codec);
+          decoder_cycles.stop();
           decoder_time.stop();
         }
-        else {
-          adaptive_model.reset();
-          encoder_time.start();
-          code_bits = Encode_Bit_Buffer(source_bits, adaptive_model, codec);
-          encoder_time.stop();
-
-          adaptive_model.reset();
-          decoder_time.start();
-          Decode_Bit_Buffer(decoded_bits, adaptive_model, codec);
-          decoder_time.stop();
-        }
+        else
+          if (pass == 1) {
+            adaptive_model.reset();
+            encoder_time.start();
+            encoder_cycles.start();
+            code_bits = Encode_Bit_Buffer(source_bits, adaptive_model, codec);
+            encoder_cycles.stop();
+            encoder_time.stop();
+
+            adaptive_model.reset();
+            decoder_time.start();
+            decoder_cycles.start();
+            Decode_Bit_Buffer(decoded_bits, adaptive_model, codec);
+            decoder_cycles.stop();
+            decoder_time.stop();
+          }
+          else {
+            double probability[2];
+            probability[0] = src.symbol_0_probability();
+            probability[1] = src.symbol_1_probability();
+            static_data_model.set_distribution(2, probability);
+            for (unsigned k = 0; k < SimulTests; k++)
+              source_data[k] = unsigned short(source_bits[k]);
+
+            encoder_time.start();
+            encoder_cycles.start();
+            if (pass == 2)
+              code_bits = Encode_Data_Buffer(source_data, static_data_model,
+                                             rans_codec);
+            else
+              code_bits = Encode_Data_Buffer(source_data, static_data_model,
+                                             tans_codec);
+            encoder_cycles.stop();
+            encoder_time.stop();
+
+            decoder_time.start();
+            decoder_cycles.start();
+            if (pass == 2)
+              Decode_Data_Buffer(decoded_data, static_data_model, rans_codec);
+            else
+              Decode_Data_Buffer(decoded_data, static_data_model, tans_codec);
+            decoder_cycles.stop();
+            decoder_time.stop();
+
+            for (unsigned k = 0; k < SimulTests; k++)
+              decoded_bits[k] = unsigned char(decoded_data[k]);
+          }
 
         result.test_symbols += SimulTests;
         result.bits_used    += code_bits;
@@ -305,12 +453,15 @@ void Binary_Benchmark(int num_cycles)
 
       result.encoder_time = encoder_time.read();
       result.decoder_time = decoder_time.read();
-      Display_Results(simul == 0, pass != 0, result, source_time.read());
+      result.encoder_cycles = encoder_cycles.read();
+      result.decoder_cycles = decoder_cycles.read();
+      Display_Results(simul == 0, pass, result, source_time.read());
     }
     entropy += entropy_increment;
   }
 
   delete [] source_bits;
+  delete [] source_data;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -341,9 +492,13 @@ void General_Benchmark(int data_symbols,
   Test_Result         result;
   Random_Data_Source  src;
   Arithmetic_Codec    codec(SimulTests << 1);
+  RANS_Codec          rans_codec(SimulTests << 1);
+  TANS_Codec          tans_codec(SimulTests << 1);
+  Huffman_Codec       huffman_codec(SimulTests << 1);
   Static_Data_Model   static_model;
   Adaptive_Data_Model adaptive_model(data_symbols);
   Chronometer         encoder_time, decoder_time, source_time;
+  Cycle_Counter       encoder_cycles, decoder_cycles;
 
                                          // assign memory for random test data
   unsigned code_bits;
@@ -355,7 +510,7 @@ void General_Benchmark(int data_symbols,
 
   for (int simul = 0; simul < num_simulations; simul++) {
 
-    for (int pass = 0; pass <= 1; pass++) {
+    for (int pass = 0; pass <= 4; pass++) {
 
       src.set_truncated_geometric(data_symbols, entropy);
       src.set_seed(8315739 + 1031 * simul + 11 * data_symbols);
@@ -368,6 +523,8 @@ void General_Benchmark(int data_symbols,
       source_time.reset();                           // reset all chronometers
       encoder_time.reset();
       decoder_time.reset();
+      encoder_cycles.reset();
+      decoder_cycles.reset();
 
       for (int cycle = 0; cycle < num_cycles; cycle++) {
 
@@ -378,24 +535,63 @@ void General_Benchmark(int data_symbols,
         if (pass == 0) {
           static_model.set_distribution(data_symbols, src.probability());
           encoder_time.start();
+          encoder_cycles.start();
           code_bits = Encode_Data_Buffer(source_data, static_model, codec);
+          encoder_cycles.stop();
           encoder_time.stop();
 
           decoder_time.start();
+          decoder_cycles.start();
           Decode_Data_Buffer(decoded_data, static_model, codec);
+          decoder_cycles.stop();
           decoder_time.stop();
         }
-        else {
-          adaptive_model.reset();
-          encoder_time.start();
-          code_bits = Encode_Data_Buffer(source_data, adaptive_model, codec);
-          encoder_time.stop();
-
-          adaptive_model.reset();
-          decoder_time.start();
-          Decode_Data_Buffer(decoded_data, adaptive_model, codec);
-          decoder_time.stop();
-        }
+        else
+          if (pass == 1) {
+            adaptive_model.reset();
+            encoder_time.start();
+            encoder_cycles.start();
+            code_bits = Encode_Data_Buffer(source_data, adaptive_model,
+                                           codec);
+            encoder_cycles.stop();
+            encoder_time.stop();
+
+            adaptive_model.reset();
+            decoder_time.start();
+            decoder_cycles.start();
+            Decode_Data_Buffer(decoded_data, adaptive_model, codec);
+            decoder_cycles.stop();
+            decoder_time.stop();
+          }
+          else {                       // pass 2 = rANS, 3 = tANS, 4 = Huffman
+            static_model.set_distribution(data_symbols, src.probability());
+            encoder_time.start();
+            encoder_cycles.start();
+            if (pass == 2)
+              code_bits = Encode_Data_Buffer(source_data, static_model,
+                                             rans_codec);
+            else
+              if (pass == 3)
+                code_bits = Encode_Data_Buffer(source_data, static_model,
+                                               tans_codec);
+              else
+                code_bits = Encode_Data_Buffer(source_data, static_model,
+                                               huffman_codec);
+            encoder_cycles.stop();
+            encoder_time.stop();
+
+            decoder_time.start();
+            decoder_cycles.start();
+            if (pass == 2)
+              Decode_Data_Buffer(decoded_data, static_model, rans_codec);
+            else
+              if (pass == 3)
+                Decode_Data_Buffer(decoded_data, static_model, tans_codec);
+              else
+                Decode_Data_Buffer(decoded_data, static_model, huffman_codec);
+            decoder_cycles.stop();
+            decoder_time.stop();
+          }
 
         result.test_symbols += SimulTests;
         result.bits_used    += code_bits;
@@ -407,7 +603,11 @@ void General_Benchmark(int data_symbols,
 
       result.encoder_time = encoder_time.read();
       result.decoder_time = decoder_time.read();
-      Display_Results(simul == 0, pass != 0, result, source_time.read());
+      result.encoder_cycles = encoder_cycles.read();
+      result.decoder_cycles = decoder_cycles.read();
+      bool fallback = (pass == 4) && !huffman_codec.huffman();
+      Display_Results(simul == 0, fallback ? 5 : pass, result,
+                      source_time.read());
     }
     entropy += entropy_increment;
   }
@@ -415,14 +615,859 @@ void General_Benchmark(int data_symbols,
   delete [] source_data;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void Precision_Benchmark(int data_symbols,
+                         int num_cycles)
+{
+                        // model precisions, and 3 entropies for each alphabet
+  bool binary = (data_symbols == 2);
+  unsigned min_bits = (binary ? 8 : 10), max_bits = 16;
+  double max_entropy = log(double(data_symbols)) / log(2.0);
+                                                                  // variables
+  Random_Bit_Source   bit_src;
+  Random_Data_Source  data_src;
+  Arithmetic_Codec    codec(SimulTests << 1);
+  Static_Bit_Model    static_bit_model;
+  Adaptive_Bit_Model  adaptive_bit_model;
+  Static_Data_Model   static_model;
+  Adaptive_Data_Model adaptive_model;
+  Chronometer         encoder_time, decoder_time;
+
+                                         // assign memory for random test data
+  unsigned code_bits;
+  unsigned char  * source_bits  = new unsigned char[2*SimulTests];
+  unsigned char  * decoded_bits = source_bits + SimulTests;
+  unsigned short * source_data  = new unsigned short[2*SimulTests];
+  unsigned short * decoded_data = source_data + SimulTests;
+  if ((source_bits == 0) || (source_data == 0))
+    Error("Cannot assign memory for random data buffer");
+
+  puts("\n================================================================="
+    "========");
+  printf(" Model precision test: %d symbols, %d x %d symbols per test\n",
+    data_symbols, num_cycles, SimulTests);
+
+  for (int e = 1; e <= 3; e++) {
+
+    double entropy;
+    if (binary) {
+      bit_src.set_entropy(0.25 * e * max_entropy);
+      entropy = bit_src.entropy();
+    }
+    else {
+      data_src.set_truncated_geometric(data_symbols, 0.25 * e * max_entropy);
+      entropy = data_src.entropy();
+    }
+
+    printf("\n Data source entropy = %8.5f bits/symbol\n\n", entropy);
+    puts(" Precision   Static model:  redundancy  encoder  decoder"
+      "   Adaptive model:  redundancy  encoder  decoder");
+
+    for (unsigned bits = min_bits; bits <= max_bits; bits++) {
+
+      printf("  %2u bits  ", bits);
+
+      for (int pass = 0; pass <= 1; pass++) {
+                          // static models need probabilities >= 2^-precision,
+                            // adaptive models at most 2^(precision-4) symbols
+        bool valid = true;
+        if (!binary && (pass == 0))
+          for (int k = 0; k < data_symbols; k++)
+            if (data_src.probability()[k] < 1.0 / double(1U << bits))
+              valid = false;
+        if (!binary && (pass == 1))
+          valid = (unsigned(data_symbols) <= (1U << (bits - 4)));
+        if (!valid) {
+          printf("                  -        -        -  ");
+          continue;
+        }
+
+        bit_src.set_seed(1839304 + 2017 * e);
+        data_src.set_seed(8315739 + 1031 * e + 11 * data_symbols);
+        double bits_used = 0;
+        encoder_time.reset();
+        decoder_time.reset();
+
+        for (int cycle = 0; cycle < num_cycles; cycle++) {
+
+          if (binary) {
+            Fill_Bit_Buffer(bit_src, source_bits);
+            if (pass == 0) {
+              static_bit_model.set_precision(bits);
+              static_bit_model.set_probability_0(
+                bit_src.symbol_0_probability());
+              encoder_time.start();
+              code_bits = Encode_Bit_Buffer(source_bits, static_bit_model,
+                                            codec);
+              encoder_time.stop();
+              decoder_time.start();
+              Decode_Bit_Buffer(decoded_bits, static_bit_model, codec);
+              decoder_time.stop();
+            }
+            else {
+              adaptive_bit_model.set_precision(bits);
+              encoder_time.start();
+              code_bits = Encode_Bit_Buffer(source_bits, adaptive_bit_model,
+                                            codec);
+              encoder_time.stop();
+              adaptive_bit_model.reset();
+              decoder_time.start();
+              Decode_Bit_Buffer(decoded_bits, adaptive_bit_model, codec);
+              decoder_time.stop();
+            }
+            for (unsigned k = 0; k < SimulTests; k++)
+              if (source_bits[k] != decoded_bits[k])
+                Error("incorrect decoding");
+          }
+          else {
+            Fill_Data_Buffer(data_src, source_data);
+            if (pass == 0) {
+              static_model.set_precision(bits);
+              static_model.set_distribution(data_symbols,
+                                            data_src.probability());
+              encoder_time.start();
+              code_bits = Encode_Data_Buffer(source_data, static_model,
+                                             codec);
+              encoder_time.stop();
+              decoder_time.start();
+              Decode_Data_Buffer(decoded_data, static_model, codec);
+              decoder_time.stop();
+            }
+            else {
+              adaptive_model.set_precision(bits);
+              adaptive_model.set_alphabet(data_symbols);
+              encoder_time.start();
+              code_bits = Encode_Data_Buffer(source_data, adaptive_model,
+                                             codec);
+              encoder_time.stop();
+              adaptive_model.reset();
+              decoder_time.start();
+              Decode_Data_Buffer(decoded_data, adaptive_model, codec);
+              decoder_time.stop();
+            }
+            for (unsigned k = 0; k < SimulTests; k++)
+              if (source_data[k] != decoded_data[k])
+                Error("incorrect decoding");
+          }
+          bits_used += code_bits;
+        }
+                                    // redundancy, and ns/symbol of each coder
+        double symbols = double(num_cycles) * SimulTests;
+        printf("   %9.4f %%  %7.3f  %7.3f  ",
+          100.0 * (bits_used / symbols - entropy) / entropy,
+          1e9 * encoder_time.read() / symbols,
+          1e9 * decoder_time.read() / symbols);
+      }
+      puts("");
+    }
+  }
+
+  puts("\n Encoder and decoder times in ns/symbol");
+  puts("====================================================================="
+    "====");
+
+  delete [] source_bits;
+  delete [] source_data;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// - - Implementations for checking coding interfaces  - - - - - - - - - - - -
+
+void Check_Passed(const char * name,
+                  int num_cycles)
+{
+  printf(" %-50s %3d cycles OK\n", name, num_cycles);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void Integer_Model_Check(int num_cycles)
+{
+                     // magnitudes from all classes, signed and unsigned data,
+                            // several contexts, and all modeled mantissa bits
+  Random_Generator       gen(1987);
+  Arithmetic_Codec       codec(8 * CheckTests);
+  Adaptive_Integer_Model model;
+  int * source  = new int[2*CheckTests];
+  int * decoded = source + CheckTests;
+
+  for (int cycle = 0; cycle < num_cycles; cycle++) {
+
+    bool signed_data = ((cycle & 1) == 0);
+    unsigned contexts = 1 + cycle % 4;
+    model.set_contexts(contexts, signed_data, cycle % 9);
+
+    for (unsigned k = 0; k < CheckTests; k++) {
+      unsigned c = gen.integer(signed_data ? 32 : 33), a = 0;     // magnitude
+      if (c) a = (1U << (c - 1)) | (gen.word() & ((1U << (c - 1)) - 1));
+      source[k] = (signed_data && (gen.word() & 1U) ? -int(a) : int(a));
+    }
+    source[0] = (signed_data ? -0x7FFFFFFF - 1 : -1);     // largest magnitude
+
+    codec.start_encoder();
+    for (unsigned k = 0; k < CheckTests; k++)
+      codec.encode(source[k], model, k % contexts);
+    codec.stop_encoder();
+
+    model.reset();
+    codec.start_decoder();
+    for (unsigned k = 0; k < CheckTests; k++)
+      decoded[k] = codec.decode(model, k % contexts);
+    codec.stop_decoder();
+
+    for (unsigned k = 0; k < CheckTests; k++)
+      if (source[k] != decoded[k]) Error("incorrect integer decoding");
+  }
+
+  Check_Passed("Adaptive integer model", num_cycles);
+  delete [] source;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void Sparse_Model_Check(int data_symbols,
+                        int num_cycles)
+{
+                   // 'data_symbols' used in alphabets of 512 to 2^16 symbols,
+                    // and every 4th cycle more than the model keeps estimates
+  Random_Generator      gen(4096);
+  Arithmetic_Codec      codec(4 * CheckTests);
+  Adaptive_Sparse_Model model;
+  unsigned * used = new unsigned[3000];
+  unsigned short * source  = new unsigned short[2*CheckTests];
+  unsigned short * decoded = source + CheckTests;
+
+  for (int cycle = 0; cycle < num_cycles; cycle++) {
+
+    unsigned alphabet = 0x10000U >> (cycle % 8);
+    unsigned used_symbols = (cycle % 4 == 3 ? 3000 : unsigned(data_symbols));
+    model.set_alphabet(alphabet);
+    for (unsigned n = 0; n < used_symbols; n++)
+      used[n] = gen.integer(alphabet);
+    for (unsigned k = 0; k < CheckTests; k++) {         // skewed distribution
+      double u = gen.uniform();
+      source[k] = (unsigned short) used[unsigned(used_symbols * u * u)];
+    }
+
+    codec.start_encoder();
+    for (unsigned k = 0; k < CheckTests; k++) codec.encode(source[k], model);
+    codec.stop_encoder();
+
+    model.reset();
+    codec.start_decoder();
+    for (unsigned k = 0; k < CheckTests; k++)
+      decoded[k] = (unsigned short) codec.decode(model);
+    codec.stop_decoder();
+
+    for (unsigned k = 0; k < CheckTests; k++)
+      if (source[k] != decoded[k]) Error("incorrect sparse model decoding");
+  }
+
+  Check_Passed("Adaptive sparse model", num_cycles);
+  delete [] used;
+  delete [] source;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void Run_Mode_Check(int num_cycles)
+{
+                       // runs ended by a different bit or by the maximum run,
+                       // coded in run mode and bit by bit: code must be equal
+  Random_Generator   gen(2828);
+  Arithmetic_Codec   run_codec(4 * CheckTests), bit_codec(4 * CheckTests);
+  Adaptive_Bit_Model run_model, bit_model;
+  const unsigned runs = CheckTests >> 4;
+  unsigned * source  = new unsigned[4*runs];                   // run lengths,
+  unsigned * max_run = source + runs;                      // maximum lengths,
+  unsigned * decoded = source + 2 * runs;                  // decoded lengths,
+  unsigned * bit     = source + 3 * runs;                      // and run bits
+
+  for (int cycle = 0; cycle < num_cycles; cycle++) {
+
+    unsigned precision = 8 + cycle % 9;
+    double mean_run = (cycle & 1 ? 3.0 : 60.0);
+    run_model.set_precision(precision);
+    bit_model.set_precision(precision);
+    for (unsigned k = 0; k < runs; k++) {
+      bit[k] = gen.word() & 1U;
+      max_run[k] = 1 + gen.integer(cycle & 2 ? 8 : 400);
+      source[k] = unsigned(-mean_run * log(gen.uniform()));
+      if (source[k] > max_run[k]) source[k] = max_run[k];
+    }
+
+    run_codec.start_encoder();
+    bit_codec.start_encoder();
+    for (unsigned k = 0; k < runs; k++) {
+      run_codec.encode_run(bit[k], source[k], max_run[k], run_model);
+      for (unsigned n = 0; n < source[k]; n++)
+        bit_codec.encode(bit[k], bit_model);
+      if (source[k] < max_run[k]) bit_codec.encode(bit[k] ^ 1U, bit_model);
+    }
+    unsigned run_bytes = run_codec.stop_encoder();
+    if ((bit_codec.stop_encoder() != run_bytes) ||
+        memcmp(run_codec.buffer(), bit_codec.buffer(), run_bytes))
+      Error("run mode code differs from bit-by-bit code");
+
+    run_model.reset();
+    run_codec.start_decoder();
+    for (unsigned k = 0; k < runs; k++)
+      decoded[k] = run_codec.decode_run(bit[k], max_run[k], run_model);
+    run_codec.stop_decoder();
+
+    for (unsigned k = 0; k < runs; k++)
+      if (source[k] != decoded[k]) Error("incorrect run decoding");
+  }
+
+  Check_Passed("Run mode with adaptive bit model", num_cycles);
+  delete [] source;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void Raw_Data_Check(int data_symbols,
+                    int num_cycles)
+{
+               // modeled symbols mixed with raw 32 and 64-bit fields and byte
+                 // arrays: short arrays are coded, long ones copied unchanged
+  Random_Generator    gen(2929);
+  Arithmetic_Codec    codec(16 * CheckTests);
+  Adaptive_Data_Model model(data_symbols);
+  const unsigned items = CheckTests >> 2;
+  unsigned * type = new unsigned[items];
+  unsigned long long * source  = new unsigned long long[2*items];
+  unsigned long long * decoded = source + items;
+  unsigned char * bytes  = new unsigned char[64*items];
+  unsigned char * copied = new unsigned char[64];
+
+  for (int cycle = 0; cycle < num_cycles; cycle++) {
+
+    unsigned position = 0;                 // byte arrays: position and length
+    for (unsigned k = 0; k < items; k++)
+      switch (type[k] = gen.integer(4)) {
+        case 0: source[k] = gen.integer(data_symbols); break;
+        case 1: source[k] = gen.word(); break;
+        case 2: source[k] = (((unsigned long long) gen.word()) << 32) |
+                            gen.word();
+                break;
+        case 3: source[k] = (((unsigned long long) position) << 8) |
+                            gen.integer(64);
+                for (unsigned n = 0; n < unsigned(source[k] & 0xFFU); n++)
+                  bytes[position++] = (unsigned char) gen.word();
+      }
+
+    model.reset();
+    codec.start_encoder();
+    for (unsigned k = 0; k < items; k++)
+      switch (type[k]) {
+        case 0: codec.encode(unsigned(source[k]), model); break;
+        case 1: codec.put_bits32(unsigned(source[k])); break;
+        case 2: codec.put_bits64(source[k]); break;
+        case 3: codec.put_bytes(bytes + (source[k] >> 8),
+                                unsigned(source[k] & 0xFFU));
+      }
+    codec.stop_encoder();
+
+    model.reset();
+    codec.start_decoder();
+    for (unsigned k = 0; k < items; k++)
+      switch (type[k]) {
+        case 0: decoded[k] = codec.decode(model); break;
+        case 1: decoded[k] = codec.get_bits32(); break;
+        case 2: decoded[k] = codec.get_bits64(); break;
+        case 3: decoded[k] = source[k];
+                codec.get_bytes(copied, unsigned(source[k] & 0xFFU));
+                if (memcmp(copied, bytes + (source[k] >> 8),
+                           unsigned(source[k] & 0xFFU)))
+                  Error("incorrect byte array decoding");
+      }
+    codec.stop_decoder();
+
+    for (unsigned k = 0; k < items; k++)
+      if (source[k] != decoded[k]) Error("incorrect raw data decoding");
+  }
+
+  Check_Passed("Raw 32 and 64-bit fields, and byte arrays", num_cycles);
+  delete [] type;
+  delete [] source;
+  delete [] bytes;
+  delete [] copied;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void Random_Items(Random_Generator & gen,
+                  unsigned data_symbols,
+                  unsigned item[],
+                  unsigned first,
+                  unsigned count)
+{
+                     // item k is data, bit, integer, or sparse symbol for k %
+                        // 4 = 0, 1, 2, 3; all skewed, so some have long codes
+  for (unsigned k = first; k < first + count; k++) {
+    double u = gen.uniform();
+    switch (k & 3) {
+      case 0: item[k] = unsigned(data_symbols * u * u); break;
+      case 1: item[k] = (u < 0.1 ? 1 : 0); break;
+      case 2: item[k] = unsigned(int(gen.word()) >> gen.integer(32)); break;
+      case 3: item[k] = unsigned(data_symbols * u * u * u);       // scattered
+              item[k] = (item[k] * 7919U) & 0xFFFFU;
+    }
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void Code_Items(Arithmetic_Codec & codec,
+                bool encoder,
+                unsigned item[],
+                unsigned first,
+                unsigned count,
+                Item_Models & M)
+{
+  for (unsigned k = first; k < first + count; k++) {
+    unsigned context = (k >> 2) & 3;
+    if (encoder)
+      switch (k & 3) {
+        case 0: codec.encode(item[k], M.data); break;
+        case 1: codec.encode(item[k], M.bit); break;
+        case 2: codec.encode(int(item[k]), M.integer, context); break;
+        case 3: codec.encode(item[k], M.sparse);
+      }
+    else
+      switch (k & 3) {
+        case 0: item[k] = codec.decode(M.data); break;
+        case 1: item[k] = codec.decode(M.bit); break;
+        case 2: item[k] = unsigned(codec.decode(M.integer, context)); break;
+        case 3: item[k] = codec.decode(M.sparse);
+      }
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void Copy_Items(Item_Models & M,
+                const Item_Models & source)
+{
+  M.data.copy(source.data);
+  M.bit.copy(source.bit);
+  M.integer.copy(source.integer);
+  M.sparse.copy(source.sparse);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void Reset_Items(Item_Models & M)
+{
+  M.data.reset();
+  M.bit.reset();
+  M.integer.reset();
+  M.sparse.reset();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void Rollback_Check(int data_symbols,
+                    int num_cycles)
+{
+               // trial encodings of each segment are undone with rollback and
+               // model copies: code must equal coding only the kept segments.
+                     // The decoder also decodes segments again after rollback
+  Random_Generator gen(3030);
+  Arithmetic_Codec codec(8 * CheckTests), straight(8 * CheckTests);
+  Item_Models      M, backup, straight_M;
+  Codec_Checkpoint point;
+  unsigned * source  = new unsigned[3*CheckTests];
+  unsigned * trial   = source + CheckTests;
+  unsigned * decoded = source + 2 * CheckTests;
+
+  M.data.set_alphabet(data_symbols);
+  straight_M.data.set_alphabet(data_symbols);
+  M.integer.set_contexts(4, true, 3);
+  straight_M.integer.set_contexts(4, true, 3);
+  M.sparse.set_alphabet(0x10000U);
+  straight_M.sparse.set_alphabet(0x10000U);
+
+  for (int cycle = 0; cycle < num_cycles; cycle++) {
+
+    unsigned segment = 1 + gen.integer(cycle & 1 ? 16 : 1000);
+    Random_Items(gen, data_symbols, source, 0, CheckTests);
+
+    Reset_Items(straight_M);
+    straight.start_encoder();
+    Code_Items(straight, true, source, 0, CheckTests, straight_M);
+    unsigned straight_bytes = straight.stop_encoder();
+
+    Reset_Items(M);
+    codec.start_encoder();
+    for (unsigned s = 0; s < CheckTests; s += segment) {
+      unsigned n = (CheckTests - s < segment ? CheckTests - s : segment);
+      codec.checkpoint(point);
+      Copy_Items(backup, M);
+      for (unsigned t = gen.integer(3); t; t--) {
+        Random_Items(gen, data_symbols, trial, s, n);
+        Code_Items(codec, true, trial, s, n, M);
+        codec.rollback(point);
+        Copy_Items(M, backup);
+      }
+      Code_Items(codec, true, source, s, n, M);
+    }
+    if ((codec.stop_encoder() != straight_bytes) ||
+        memcmp(codec.buffer(), straight.buffer(), straight_bytes))
+      Error("code after rollback differs from straight code");
+
+    Reset_Items(M);
+    codec.start_decoder();
+    for (unsigned s = 0; s < CheckTests; s += segment) {
+      unsigned n = (CheckTests - s < segment ? CheckTests - s : segment);
+      codec.checkpoint(point);
+      Copy_Items(backup, M);
+      Code_Items(codec, false, decoded, s, n, M);
+      if (gen.word() & 1U) {
+        codec.rollback(point);
+        Copy_Items(M, backup);
+        memset(decoded + s, 0, n * sizeof(unsigned));
+        Code_Items(codec, false, decoded, s, n, M);
+      }
+    }
+    codec.stop_decoder();
+
+    for (unsigned k = 0; k < CheckTests; k++)
+      if (source[k] != decoded[k]) Error("incorrect decoding after rollback");
+  }
+
+  Check_Passed("Checkpoint, rollback, and model copies", num_cycles);
+  delete [] source;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void Estimate_Check(int data_symbols,
+                    int num_cycles)
+{
+                // sum of static model costs and adaptive model estimates must
+              // be within 0.5% of code_bits(); and estimate() must update the
+                   // models like encode(), so the code of later data is equal
+  Random_Bit_Source   bit_src;
+  Random_Data_Source  data_src;
+  Arithmetic_Codec    codec(4 * CheckTests), estimated_codec(4 * CheckTests);
+  Static_Bit_Model    static_bit_model;
+  Static_Data_Model   static_data_model;
+  Adaptive_Bit_Model  bit_model, estimated_bit_model;
+  Adaptive_Data_Model data_model(data_symbols);
+  Adaptive_Data_Model estimated_data_model(data_symbols);
+  double * probability = new double[data_symbols];
+  unsigned * source = new unsigned[CheckTests];
+  double max_entropy = log(double(data_symbols)) / log(2.0);
+
+  bit_src.set_seed(3131);
+  data_src.set_seed(3232);
+
+  for (int cycle = 0; cycle < num_cycles; cycle++) {
+
+    unsigned precision = 8 + cycle % 9;
+    bit_model.set_precision(precision);
+    estimated_bit_model.set_precision(precision);
+    data_model.reset();
+    estimated_data_model.reset();
+
+    double entropy = max_entropy * (0.2 + 0.15 * (cycle % 5));
+    bit_src.set_entropy(0.1 + 0.2 * (cycle % 5));
+    data_src.set_truncated_geometric(data_symbols, entropy);
+    double sum = 0;                       // static model needs no tiny values
+    for (int n = 0; n < data_symbols; n++)
+      sum += (probability[n] = data_src.probability()[n] + MinProbability);
+    for (int n = 0; n < data_symbols; n++) probability[n] /= sum;
+    static_bit_model.set_probability_0(bit_src.symbol_0_probability());
+    static_data_model.set_distribution(data_symbols, probability);
+
+    for (unsigned k = 0; k < CheckTests; k++)
+      source[k] = (k & 1 ? data_src.data() : bit_src.bit());
+
+    unsigned long long cost = 0;                         // 256 x bits, summed
+    codec.start_encoder();
+    for (unsigned k = 0; k < CheckTests; k++)
+      switch (k & 3) {
+        case 0: codec.encode(source[k], static_bit_model);
+                cost += static_bit_model.cost(source[k]);
+                break;
+        case 1: codec.encode(source[k], static_data_model);
+                cost += static_data_model.cost(source[k]);
+                break;
+        case 2: codec.encode(source[k], bit_model);
+                cost += estimated_bit_model.estimate(source[k]);
+                break;
+        case 3: codec.encode(source[k], data_model);
+                cost += estimated_data_model.estimate(source[k]);
+      }
+    double code_bits = codec.code_bits(), estimate = cost / 256.0;
+    codec.stop_encoder();
+    if (fabs(estimate - code_bits) > 0.005 * code_bits + 64.0)
+      Error("bit estimates differ from code size");
+
+    codec.start_encoder();
+    estimated_codec.start_encoder();
+    for (unsigned k = 0; k < CheckTests; k += 2)
+      if (k & 2) {
+        codec.encode(source[k+1], data_model);
+        estimated_codec.encode(source[k+1], estimated_data_model);
+      }
+      else {
+        codec.encode(source[k], bit_model);
+        estimated_codec.encode(source[k], estimated_bit_model);
+      }
+    unsigned bytes = codec.stop_encoder();
+    if ((estimated_codec.stop_encoder() != bytes) ||
+        memcmp(codec.buffer(), estimated_codec.buffer(), bytes))
+      Error("estimate and encode update models differently");
+  }
+
+  Check_Passed("Costs and estimates of static and adaptive models",
+               num_cycles);
+  delete [] probability;
+  delete [] source;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void Split_Stream_Check(int data_symbols,
+                        int num_cycles)
+{
+               // symbol k goes to substream k % streams, with a shared static
+               // model for odd k. Adaptive models for even k are one for each
+                  // substream, decoded one substream at a time, or one shared
+                                      // by all, decoded in the original order
+  Random_Generator      gen(4646);
+  Split_Stream_Codec    encoder, decoder;
+  Static_Data_Model     static_model;
+  Adaptive_Data_Model * model = new Adaptive_Data_Model[256];
+  unsigned * source  = new unsigned[2*CheckTests];
+  unsigned * decoded = source + CheckTests;
+
+  static_model.set_distribution(data_symbols);
+  for (unsigned n = 0; n < 256; n++) model[n].set_alphabet(data_symbols);
+
+  for (int cycle = 0; cycle < num_cycles; cycle++) {
+
+    unsigned streams = (cycle % 5 == 4 ? 256 : 1 + cycle % 8);
+    bool shared = (cycle & 1) != 0;
+    encoder.set_streams(streams, 4 * (CheckTests / streams + 16));
+    for (unsigned k = 0; k < CheckTests; k++) {
+      double u = gen.uniform();
+      source[k] = unsigned(data_symbols * u * u);
+    }
+
+    for (unsigned n = 0; n < streams; n++) model[n].reset();
+    encoder.start_encoder();
+    for (unsigned k = 0; k < CheckTests; k++) {
+      unsigned n = k % streams;
+      if (k & 1)
+        encoder.stream(n).encode(source[k], static_model);
+      else
+        encoder.stream(n).encode(source[k], model[shared ? 0 : n]);
+    }
+    unsigned bytes = encoder.stop_encoder();
+
+    for (unsigned n = 0; n < streams; n++) model[n].reset();
+    decoder.start_decoder(encoder.buffer(), bytes);
+    if (decoder.streams() != streams) Error("incorrect number of substreams");
+    if (shared)
+      for (unsigned k = 0; k < CheckTests; k++)
+        if (k & 1)
+          decoded[k] = decoder.stream(k % streams).decode(static_model);
+        else
+          decoded[k] = decoder.stream(k % streams).decode(model[0]);
+    else
+      for (unsigned n = 0; n < streams; n++)
+        for (unsigned k = n; k < CheckTests; k += streams)
+          if (k & 1)
+            decoded[k] = decoder.stream(n).decode(static_model);
+          else
+            decoded[k] = decoder.stream(n).decode(model[n]);
+    decoder.stop_decoder();
+
+    for (unsigned k = 0; k < CheckTests; k++)
+      if (source[k] != decoded[k]) Error("incorrect substream decoding");
+  }
+
+  Check_Passed("Split streams, with static and adaptive models", num_cycles);
+  delete [] model;
+  delete [] source;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+unsigned Test_Block(Random_Generator & gen,
+                    int cycle,
+                    unsigned char data[])
+{
+             // block types cycle over empty, 1 byte, all bytes equal, largest
+         // size, and random size; data has skewed bytes and repeated segments
+  unsigned bytes;
+  switch (cycle % 5) {
+    case 0: return 0;
+    case 1: data[0] = (unsigned char) gen.word();
+            return 1;
+    case 2: bytes = 1 + gen.integer(MaxBlockBytes);
+            memset(data, int(gen.word() & 0xFFU), bytes);
+            return bytes;
+    case 3: bytes = MaxBlockBytes; break;
+    default: bytes = 1 + gen.integer(1U << 16);
+  }
+
+  for (unsigned p = 0; p < bytes; )
+    if ((p > 64) && (gen.integer(4) == 0)) {
+      unsigned d = 1 + gen.integer(p < 0x10000U ? p : 0x10000U);
+      for (unsigned n = 4 + gen.integer(60); n && (p < bytes); n--, p++)
+        data[p] = data[p-d];
+    }
+    else {
+      double u = gen.uniform();
+      data[p++] = (unsigned char) (256.0 * u * u * u);
+    }
+  return bytes;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void LZ77_Check(int num_cycles)
+{
+                     // match finders are kept between blocks, like in acfile,
+                                      // and each block starts with new models
+  Random_Generator gen(1977);
+  Arithmetic_Codec codec(2 * MaxBlockBytes);
+  Context_Model    literals(2, 12);
+  LZ77_Codec       encoder, decoder;
+  unsigned char * source  = new unsigned char[2*MaxBlockBytes];
+  unsigned char * decoded = source + MaxBlockBytes;
+
+  for (int cycle = 0; cycle < num_cycles; cycle++) {
+
+    unsigned bytes = Test_Block(gen, cycle, source);
+
+    literals.reset();
+    encoder.reset();
+    codec.start_encoder();
+    encoder.encode(codec, literals, source, bytes);
+    codec.stop_encoder();
+
+    literals.reset();
+    decoder.reset();
+    codec.start_decoder();
+    decoder.decode(codec, literals, decoded, bytes);
+    codec.stop_decoder();
+
+    if (memcmp(source, decoded, bytes)) Error("incorrect LZ77 decoding");
+  }
+
+  Check_Passed("LZ77 blocks, with order-2 literal contexts", num_cycles);
+  delete [] source;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void BWT_Check(int num_cycles)
+{
+                   // buffers are kept between blocks, like in acfile, and the
+                 // largest blocks are split in segments for the inverse walks
+  Random_Generator gen(1994);
+  Arithmetic_Codec codec(2 * MaxBlockBytes);
+  Context_Model    classes(1, 8);
+  BWT_Codec        encoder, decoder;
+  unsigned char * source  = new unsigned char[2*MaxBlockBytes];
+  unsigned char * decoded = source + MaxBlockBytes;
+
+  for (int cycle = 0; cycle < num_cycles; cycle++) {
+
+    unsigned bytes = Test_Block(gen, cycle, source);
+
+    classes.reset();
+    encoder.reset();
+    codec.start_encoder();
+    encoder.encode(codec, classes, source, bytes);
+    codec.stop_encoder();
+
+    classes.reset();
+    decoder.reset();
+    codec.start_decoder();
+    decoder.decode(codec, classes, decoded, bytes);
+    codec.stop_decoder();
+
+    if (memcmp(source, decoded, bytes)) Error("incorrect BWT decoding");
+  }
+
+  Check_Passed("BWT blocks, with order-1 rank class contexts", num_cycles);
+  delete [] source;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void PPM_Check(int num_cycles)
+{
+                 // order-8 contexts in 2 MB of trie memory, so largest blocks
+                                  // also check restarts when the trie is full
+  Random_Generator gen(1984);
+  Arithmetic_Codec codec(2 * MaxBlockBytes);
+  PPM_Codec        encoder(8, 1), decoder(8, 1);
+  unsigned char * source  = new unsigned char[2*MaxBlockBytes];
+  unsigned char * decoded = source + MaxBlockBytes;
+
+  for (int cycle = 0; cycle < num_cycles; cycle++) {
+
+    unsigned bytes = Test_Block(gen, cycle, source);
+
+    encoder.reset();
+    codec.start_encoder();
+    encoder.encode(codec, source, bytes);
+    codec.stop_encoder();
+
+    decoder.reset();
+    codec.start_decoder();
+    decoder.decode(codec, decoded, bytes);
+    codec.stop_decoder();
+
+    if (memcmp(source, decoded, bytes)) Error("incorrect PPM decoding");
+  }
+
+  Check_Passed("PPM blocks, with trie restarts", num_cycles);
+  delete [] source;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void Interface_Check(int data_symbols,
+                     int num_cycles)
+{
+  puts("\n================================================================="
+    "========");
+  printf(" Coding interface checks: decoded data must equal source data\n\n");
+
+  Integer_Model_Check(num_cycles);
+  Sparse_Model_Check(data_symbols, num_cycles);
+  Run_Mode_Check(num_cycles);
+  Raw_Data_Check(data_symbols, num_cycles);
+  Rollback_Check(data_symbols, num_cycles);
+  Estimate_Check(data_symbols, num_cycles);
+  Split_Stream_Check(data_symbols, num_cycles);
+  LZ77_Check(num_cycles);
+  BWT_Check(num_cycles);
+  PPM_Check(num_cycles);
+
+  puts("====================================================================="
+    "====");
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 // - - Main function - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
 int main(int numb_arg, char * arg[])
 {
                             // set number of tests from command-line parameter 
-  if ((numb_arg != 2) && ((numb_arg != 3))) {
-    puts(" Parameters: alphabet_symbols [test_cycles=10]");
+  if ((numb_arg < 2) || (numb_arg > 4)) {
+    puts(" Parameters: alphabet_symbols [test_cycles=10] [p | c]");
+    puts("             p = compare model precisions");
+    puts("             c = check coding interfaces");
     return 0;
   }
 
@@ -430,10 +1475,17 @@ int main(int numb_arg, char * arg[])
   if ((ns < 2) || (ns > 500)) Error("invalid number of data symbols");
   if ((tc < 1) || (tc > 999)) Error("invalid number of simulations");
 
-  if (ns == 2)
-    Binary_Benchmark(tc);
+  if (numb_arg == 4)
+    switch (arg[3][0]) {
+      case 'p': Precision_Benchmark(ns, tc); break;
+      case 'c': Interface_Check(ns, tc); break;
+      default:  Error("invalid test option");
+    }
   else
-    General_Benchmark(ns, tc);
+    if (ns == 2)
+      Binary_Benchmark(tc);
+    else
+      General_Benchmark(ns, tc);
 
   return 0;
 }
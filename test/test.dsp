@@ -93,10 +93,42 @@ SOURCE=..\arithmetic_codec.cpp
 # End Source File
 # Begin Source File
 
+SOURCE=..\bwt_codec.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=..\context_model.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=..\huffman_codec.cpp
+# End Source File
+# Begin Source File
+
 SOURCE=.\codec_test.cpp
 # End Source File
 # Begin Source File
 
+SOURCE=..\lz77_codec.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=..\ppm_codec.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=..\rans_codec.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=..\split_stream_codec.cpp
+# End Source File
+# Begin Source File
+
+SOURCE=..\tans_codec.cpp
+# End Source File
+# Begin Source File
+
 SOURCE=.\test_support.cpp
 # End Source File
 # End Group
@@ -109,6 +141,38 @@ SOURCE=..\arithmetic_codec.h
 # End Source File
 # Begin Source File
 
+SOURCE=..\bwt_codec.h
+# End Source File
+# Begin Source File
+
+SOURCE=..\context_model.h
+# End Source File
+# Begin Source File
+
+SOURCE=..\huffman_codec.h
+# End Source File
+# Begin Source File
+
+SOURCE=..\lz77_codec.h
+# End Source File
+# Begin Source File
+
+SOURCE=..\ppm_codec.h
+# End Source File
+# Begin Source File
+
+SOURCE=..\rans_codec.h
+# End Source File
+# Begin Source File
+
+SOURCE=..\split_stream_codec.h
+# End Source File
+# Begin Source File
+
+SOURCE=..\tans_codec.h
+# End Source File
+# Begin Source File
+
 SOURCE=.\test_support.h
 # End Source File
 # End Group
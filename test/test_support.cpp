@@ -41,6 +41,14 @@
 
 #include "test_support.h"
 
+#if defined(_MSC_VER) && (_MSC_VER >= 1400)
+#include <intrin.h>
+#define CYCLE_COUNTER
+#elif defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+#include <x86intrin.h>
+#define CYCLE_COUNTER
+#endif
+
 #ifdef CLOCKS_PER_SEC
 const double ClockRate = 1.0 / CLOCKS_PER_SEC;
 #else
@@ -124,6 +132,49 @@ void Chronometer::display(char * s)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+static inline unsigned long long Cycle_Count(void)
+{
+#ifdef CYCLE_COUNTER
+  return __rdtsc();                            // processor time-stamp counter
+#else
+  return 0;
+#endif
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void Cycle_Counter::start(void)
+{
+  if (on)
+    puts("cycle counter already on!");
+  else {
+    on   = true;
+    mark = Cycle_Count();
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void Cycle_Counter::stop(void)
+{
+  if (on) {
+    on = false;
+    cycles += Cycle_Count() - mark;
+  }
+  else
+    puts("cycle counter already off!");
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+double Cycle_Counter::read(void)
+{
+  return double(on ? cycles + (Cycle_Count() - mark) : cycles);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
 void Random_Generator::set_seed(unsigned seed)
 {
   s1 = (seed ? seed & 0xFFFFFFFU : 0x147AE11U);
@@ -66,6 +66,25 @@ private:  //  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+class Cycle_Counter
+{                                     // Class to count processor clock cycles
+public:
+
+  Cycle_Counter(void)  { cycles = 0;  on = false; }
+
+  void   reset(void) { cycles = 0;  on = false; }
+
+  void   start(void);
+  void   stop(void);
+  double read(void);                     // returns 0 if counter not available
+
+private:  //  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .  .
+  bool   on;
+  unsigned long long mark, cycles;
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
 class Random_Generator
 {                                            // Pseudo-random number generator
 public: